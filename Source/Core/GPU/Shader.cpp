@@ -2,10 +2,51 @@
 
 #include <fstream>
 #include <iostream>
+#include <cstdint>
+#include <cstring>
 #include <include/gl.h>
 
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif
+
 using namespace std;
 
+string Shader::binaryCacheDirectory;
+
+namespace
+{
+	// Header of the files in the program binary cache
+	struct ProgramBinaryHeader
+	{
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceHash;
+		uint32_t binaryFormat;
+		uint32_t binaryLength;
+	};
+
+	const uint32_t PROGRAM_BINARY_MAGIC = 0x4E425047;	// "GPBN"
+	const uint32_t PROGRAM_BINARY_VERSION = 1;
+
+	void HashBytes(uint64_t &hash, const void *data, size_t size)
+	{
+		const unsigned char *bytes = static_cast<const unsigned char*>(data);
+		for (size_t i = 0; i < size; i++) {
+			hash ^= bytes[i];
+			hash *= 0x100000001B3ull;
+		}
+	}
+
+	void HashString(uint64_t &hash, const char *str)
+	{
+		// Include the terminator, so the strings can't run into each other
+		if (str) HashBytes(hash, str, strlen(str) + 1);
+	}
+}
+
 Shader::Shader(const char * name)
 {
 	program = 0;
@@ -60,6 +101,49 @@ GLint Shader::GetUniformLocation(const char *uniformName) const
 	return glGetUniformLocation(program, uniformName);
 }
 
+GLint Shader::GetCachedUniformLocation(const string &uniformName) const
+{
+	auto it = uniformLocations.find(uniformName);
+	if (it == uniformLocations.end())
+		return INVALID_LOC;
+	return it->second;
+}
+
+const unordered_map<string, GLint>& Shader::GetActiveUniforms() const
+{
+	return uniformLocations;
+}
+
+void Shader::ReflectUniforms()
+{
+	uniformLocations.clear();
+
+	GLint count = 0, maxLength = 0;
+	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+	glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+
+	vector<GLchar> buffer(maxLength + 1);
+	for (GLint i = 0; i < count; i++) {
+		GLint size = 0;
+		GLenum type;
+		GLsizei length = 0;
+		glGetActiveUniform(program, (GLuint)i, (GLsizei)buffer.size(), &length, &size, &type, &buffer[0]);
+
+		string name(&buffer[0], length);
+		uniformLocations[name] = glGetUniformLocation(program, name.c_str());
+
+		// Arrays of basic types are reported once, as "name[0]"
+		if (name.size() > 3 && name.compare(name.size() - 3, 3, "[0]") == 0) {
+			string base = name.substr(0, name.size() - 3);
+			uniformLocations[base] = uniformLocations[name];
+			for (GLint j = 1; j < size; j++) {
+				string element = base + "[" + to_string(j) + "]";
+				uniformLocations[element] = glGetUniformLocation(program, element.c_str());
+			}
+		}
+	}
+}
+
 void Shader::OnLoad(function<void()> onLoad)
 {
 	loadObservers.push_back(onLoad);
@@ -67,6 +151,8 @@ void Shader::OnLoad(function<void()> onLoad)
 
 void Shader::GetUniforms()
 {
+	ReflectUniforms();
+
 	// MVP
 	loc_model_matrix	= GetUniformLocation("Model");
 	loc_view_matrix		= GetUniformLocation("View");
@@ -113,42 +199,167 @@ void Shader::AddShader(const string & shaderFile, GLenum shaderType)
 
 unsigned int Shader::CreateAndLink()
 {
-	vector<unsigned int> shaders;
-
-	// Compile shaders
+	vector<string> sources;
 	for (auto S : shaderFiles) {
-		auto shaderID = Shader::CreateShader(S.file, S.type);
-		if (shaderID) {
-			shaders.push_back(shaderID);
-		}
-		else {
-			return 0;
-		}
+		sources.push_back(Shader::ReadShaderFile(S.file));
+	}
+
+	// Try the program binary saved by a previous run
+	bool useBinaryCache = !binaryCacheDirectory.empty() && IsBinaryCacheSupported();
+	unsigned long long sourceHash = 0;
+	if (useBinaryCache) {
+		sourceHash = ComputeSourceHash(sources);
+		program = LoadProgramBinary(sourceHash);
 	}
 
-	// Create Program and Link
-	if (shaders.size()) {
-		program = Shader::CreateProgram(shaders);
+	if (!program)
+	{
+		vector<unsigned int> shaders;
+
+		// Compile shaders
+		for (size_t i = 0; i < shaderFiles.size(); i++) {
+			auto shaderID = Shader::CreateShader(shaderFiles[i].file, sources[i], shaderFiles[i].type);
+			if (shaderID) {
+				shaders.push_back(shaderID);
+			}
+			else {
+				return 0;
+			}
+		}
 
-		if (program)
-		{
-			glUseProgram(program);
-			GetUniforms();
-			for (auto Observer : loadObservers) {
-				Observer();
+		// Create Program and Link
+		if (shaders.size()) {
+			program = Shader::CreateProgram(shaders, useBinaryCache);
+			if (program && useBinaryCache) {
+				SaveProgramBinary(sourceHash);
 			}
-			return program;
 		}
 	}
+
+	if (program)
+	{
+		glUseProgram(program);
+		GetUniforms();
+		for (auto Observer : loadObservers) {
+			Observer();
+		}
+		return program;
+	}
 	return 0;
 }
 
+void Shader::SetBinaryCache(const string &directory)
+{
+	binaryCacheDirectory = directory;
+	if (directory.empty())
+		return;
+
+	// Create the directory if it doesn't exist
+#ifdef _WIN32
+	_mkdir(directory.c_str());
+#else
+	mkdir(directory.c_str(), 0755);
+#endif
+}
+
+bool Shader::IsBinaryCacheSupported()
+{
+	static int supported = -1;
+	if (supported == -1) {
+		GLint formats = 0;
+		if (GLEW_VERSION_4_1 || GLEW_ARB_get_program_binary)
+			glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+		supported = formats > 0;
+	}
+	return supported == 1;
+}
+
+unsigned long long Shader::ComputeSourceHash(const vector<string> &sources) const
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+
+	// A binary can only be loaded by the driver that created it
+	HashString(hash, reinterpret_cast<const char*>(glGetString(GL_VENDOR)));
+	HashString(hash, reinterpret_cast<const char*>(glGetString(GL_RENDERER)));
+	HashString(hash, reinterpret_cast<const char*>(glGetString(GL_VERSION)));
+
+	for (size_t i = 0; i < sources.size(); i++) {
+		HashBytes(hash, &shaderFiles[i].type, sizeof(shaderFiles[i].type));
+		HashString(hash, sources[i].c_str());
+	}
+	return hash;
+}
+
+string Shader::GetBinaryCacheFile() const
+{
+	return binaryCacheDirectory + "/" + shaderName + ".bin";
+}
+
+unsigned int Shader::LoadProgramBinary(unsigned long long sourceHash)
+{
+	ifstream file(GetBinaryCacheFile().c_str(), ios::in | ios::binary);
+	if (!file.good())
+		return 0;
+
+	ProgramBinaryHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)))
+		return 0;
+
+	// Compiled from other sources, or by another driver
+	if (header.magic != PROGRAM_BINARY_MAGIC || header.version != PROGRAM_BINARY_VERSION || header.sourceHash != sourceHash)
+		return 0;
+
+	vector<char> binary(header.binaryLength);
+	if (binary.empty() || !file.read(&binary[0], binary.size()))
+		return 0;
+
+	unsigned int glProgramObject = glCreateProgram();
+	glProgramBinary(glProgramObject, header.binaryFormat, &binary[0], (GLsizei)binary.size());
+
+	// The driver can reject a binary even if it matches (after an update, for example)
+	int linkResult = 0;
+	glGetProgramiv(glProgramObject, GL_LINK_STATUS, &linkResult);
+	if (linkResult == GL_FALSE) {
+		glDeleteProgram(glProgramObject);
+		return 0;
+	}
+
+	cout << "\tPROGRAM = " << shaderName << "\t ..... LOADED FROM CACHE " << endl;
+	return glProgramObject;
+}
+
+void Shader::SaveProgramBinary(unsigned long long sourceHash) const
+{
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	vector<char> binary(length);
+	GLenum binaryFormat = 0;
+	glGetProgramBinary(program, length, &length, &binaryFormat, &binary[0]);
+
+	ProgramBinaryHeader header;
+	header.magic = PROGRAM_BINARY_MAGIC;
+	header.version = PROGRAM_BINARY_VERSION;
+	header.sourceHash = sourceHash;
+	header.binaryFormat = binaryFormat;
+	header.binaryLength = (uint32_t)length;
+
+	ofstream file(GetBinaryCacheFile().c_str(), ios::out | ios::binary | ios::trunc);
+	if (!file.good())
+		return;
+
+	file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	file.write(&binary[0], length);
+}
+
 void Shader::ClearShaders()
 {
 	shaderFiles.clear();
 }
 
-unsigned int Shader::CreateShader(const string &shaderFile, GLenum shaderType)
+string Shader::ReadShaderFile(const string &shaderFile)
 {
 	string shader_code;
 	ifstream file(shaderFile.c_str(), ios::in);
@@ -158,8 +369,6 @@ unsigned int Shader::CreateShader(const string &shaderFile, GLenum shaderType)
 		terminate();
 	}
 
-	cout << "\tFILE = " << shaderFile;
-
 	// Get file content
 	file.seekg(0, ios::end);
 	shader_code.resize((unsigned int)file.tellg());
@@ -167,6 +376,13 @@ unsigned int Shader::CreateShader(const string &shaderFile, GLenum shaderType)
 	file.read(&shader_code[0], shader_code.size());
 	file.close();
 
+	return shader_code;
+}
+
+unsigned int Shader::CreateShader(const string &shaderFile, const string &shader_code, GLenum shaderType)
+{
+	cout << "\tFILE = " << shaderFile;
+
 	int infoLogLength = 0;
 	int compileResult = 0;
 	unsigned int glShaderObject;
@@ -216,7 +432,7 @@ unsigned int Shader::CreateShader(const string &shaderFile, GLenum shaderType)
 	return glShaderObject;
 }
 
-unsigned int Shader::CreateProgram(const vector<unsigned int> &shaderObjects)
+unsigned int Shader::CreateProgram(const vector<unsigned int> &shaderObjects, bool retrievable)
 {
 	int infoLogLength = 0;
 	int linkResult = 0;
@@ -227,6 +443,10 @@ unsigned int Shader::CreateProgram(const vector<unsigned int> &shaderObjects)
 	for (auto shader: shaderObjects)
 		glAttachShader(glProgramObject, shader);
 
+	// Needed to save the program with glGetProgramBinary
+	if (retrievable)
+		glProgramParameteri(glProgramObject, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+
 	glLinkProgram(glProgramObject);
 	glGetProgramiv(glProgramObject, GL_LINK_STATUS, &linkResult);
 
@@ -2,6 +2,7 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <unordered_map>
 #include <functional>
 
 #include <include/gl.h>
@@ -28,12 +29,30 @@ class Shader
 		void BindTexturesUnits();
 		GLint GetUniformLocation(const char * uniformName) const;
 
+		// Get the location of an active uniform from the reflection cache (filled after linking),
+		// without querying the driver. Returns INVALID_LOC if the uniform is not used by the program
+		GLint GetCachedUniformLocation(const std::string &uniformName) const;
+		const std::unordered_map<std::string, GLint>& GetActiveUniforms() const;
+
 		void OnLoad(std::function<void()> onLoad);
 
+		// Save the linked programs in a directory (with glGetProgramBinary) and load them from there on the
+		// next runs, if the sources and the driver didn't change. An empty directory disables the cache
+		static void SetBinaryCache(const std::string &directory);
+
 	private:
 		void GetUniforms();
-		static unsigned int CreateShader(const std::string &shaderFile, GLenum shaderType);
-		static unsigned int CreateProgram(const std::vector<unsigned int> &shaderObjects);
+		void ReflectUniforms();
+		static std::string ReadShaderFile(const std::string &shaderFile);
+		static unsigned int CreateShader(const std::string &shaderFile, const std::string &shaderCode, GLenum shaderType);
+		static unsigned int CreateProgram(const std::vector<unsigned int> &shaderObjects, bool retrievable);
+
+		// Program binary cache
+		static bool IsBinaryCacheSupported();
+		unsigned long long ComputeSourceHash(const std::vector<std::string> &sources) const;
+		std::string GetBinaryCacheFile() const;
+		unsigned int LoadProgramBinary(unsigned long long sourceHash);
+		void SaveProgramBinary(unsigned long long sourceHash) const;
 
 	public:
 		GLuint program;
@@ -75,6 +94,9 @@ class Shader
 		};
 
 		std::string shaderName;
+		std::unordered_map<std::string, GLint> uniformLocations;
 		std::vector<ShaderFile> shaderFiles;
 		std::list<std::function<void()>> loadObservers;
+
+		static std::string binaryCacheDirectory;
 };
@@ -75,6 +75,14 @@ bool Texture2D::Load2D(const char* fileName, GLenum wrapping_mode)
 	cout << width << " * " << height << " channels: " << chn << endl << endl;
 	#endif
 
+	Load2DFromMemory(data, width, height, chn, wrapping_mode);
+
+	stbi_image_free(data);
+	return true;
+}
+
+void Texture2D::Load2DFromMemory(const unsigned char* data, int width, int height, int chn, GLenum wrapping_mode)
+{
 	textureMinFilter = GL_LINEAR_MIPMAP_LINEAR;
 	wrappingMode = wrapping_mode;
 
@@ -83,9 +91,6 @@ bool Texture2D::Load2D(const char* fileName, GLenum wrapping_mode)
 	glGenerateMipmap(targetType);
 	glBindTexture(targetType, 0);
 	CheckOpenGLError();
-
-	stbi_image_free(data);
-	return true;
 }
 
 void Texture2D::SaveToFile(const char * fileName) const
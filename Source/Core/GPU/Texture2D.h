@@ -20,6 +20,8 @@ class Texture2D
 		void CreateU16(const unsigned short* img, int width, int height, int chn);
 
 		bool Load2D(const char* fileName, GLenum wrappingMode = GL_REPEAT);
+		// Create a mipmapped texture from decoded pixels (data can be an offset in the bound GL_PIXEL_UNPACK_BUFFER)
+		void Load2DFromMemory(const unsigned char* data, int width, int height, int chn, GLenum wrappingMode = GL_REPEAT);
 		void SaveToFile(const char* fileName) const;
 
 		unsigned int GetWidth() const;
@@ -1,5 +1,7 @@
 #include "World.h"
 
+#include <cmath>
+
 #include <Core/Engine.h>
 #include <Component/CameraInput.h>
 #include <Component/Transform/Transform.h>
@@ -9,6 +11,9 @@ World::World()
 	previousTime = 0;
 	elapsedTime = 0;
 	deltaTime = 0;
+	fixedDeltaTime = 1.0 / 60.0;
+	accumulator = 0;
+	maxTicksPerFrame = 8;
 	paused = false;
 	shouldClose = false;
 
@@ -42,6 +47,23 @@ double World::GetLastFrameTime()
 	return deltaTime;
 }
 
+void World::SetTickRate(double ticksPerSecond, unsigned int maxTicksPerFrame)
+{
+	fixedDeltaTime = 1.0 / ticksPerSecond;
+	this->maxTicksPerFrame = maxTicksPerFrame;
+	accumulator = 0;
+}
+
+double World::GetFixedDeltaTime()
+{
+	return fixedDeltaTime;
+}
+
+float World::GetInterpolationAlpha()
+{
+	return static_cast<float>(accumulator / fixedDeltaTime);
+}
+
 void World::ComputeFrameDeltaTime()
 {
 	elapsedTime = Engine::GetElapsedTime();
@@ -62,6 +84,9 @@ void World::LoopUpdate()
 	// OnInputUpdate will be called each frame, the other functions are called only if an event is registered
 	window->UpdateObservers();
 
+	// Fixed time step updates
+	FixedLoopUpdate();
+
 	// Frame processing
 	FrameStart();
 	Update(static_cast<float>(deltaTime));
@@ -69,4 +94,27 @@ void World::LoopUpdate()
 
 	// Swap front and back buffers - image will be displayed to the screen
 	window->SwapBuffers();
+}
+
+void World::FixedLoopUpdate()
+{
+	if (paused)
+		return;
+
+	accumulator += deltaTime;
+
+	unsigned int ticks = 0;
+	while (accumulator >= fixedDeltaTime && ticks < maxTicksPerFrame)
+	{
+		FixedUpdate(static_cast<float>(fixedDeltaTime));
+		accumulator -= fixedDeltaTime;
+		ticks++;
+	}
+
+	// Avoid the "spiral of death" - if the simulation can't keep up, drop the time
+	// that couldn't be simulated in this frame instead of accumulating it
+	if (accumulator >= fixedDeltaTime)
+	{
+		accumulator = std::fmod(accumulator, fixedDeltaTime);
+	}
 }
\ No newline at end of file
@@ -17,20 +17,36 @@ class World : public InputController
 		virtual void Update(float deltaTimeSeconds) {};
 		virtual void FrameEnd() {};
 
+		// Called with a constant time step, zero or more times per frame (before Update)
+		virtual void FixedUpdate(float fixedDeltaTimeSeconds) {};
+
 		virtual void Run() final;
 		virtual void Pause() final;
 		virtual void Exit() final;
 
 		virtual double GetLastFrameTime() final;
 
+		// Set the number of fixed updates per second and the maximum number of fixed updates
+		// that can run in a frame (if the frame took too long, the remaining time is dropped)
+		virtual void SetTickRate(double ticksPerSecond, unsigned int maxTicksPerFrame = 8) final;
+		virtual double GetFixedDeltaTime() final;
+
+		// How far the current frame is between the last two fixed updates, in [0, 1)
+		// Used to interpolate the rendered objects between the last two simulation states
+		virtual float GetInterpolationAlpha() final;
+
 	private:
 		void ComputeFrameDeltaTime();
 		void LoopUpdate();
+		void FixedLoopUpdate();
 
 	private:
 		double previousTime;
 		double elapsedTime;
 		double deltaTime;
+		double fixedDeltaTime;
+		double accumulator;
+		unsigned int maxTicksPerFrame;
 		bool paused;
 		bool shouldClose;
 };
\ No newline at end of file
@@ -1,14 +1,71 @@
 #include <ctime>
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
 
 using namespace std;
 
 #include <Core/Engine.h>
 #include <src/GameManager.hpp>
+#include <src/Benchmarks.hpp>
 
 int main(int argc, char **argv)
 {
-	srand((unsigned int)time(NULL));
+	// Run only the game logic, without creating a window
+	// Usage: --headless [ticks] [seed]
+	if (argc > 1 && strcmp(argv[1], "--headless") == 0) {
+		unsigned long ticks = argc > 2 ? strtoul(argv[2], nullptr, 10) : 100000;
+		unsigned int seed = argc > 3 ? (unsigned int)strtoul(argv[3], nullptr, 10) : (unsigned int)time(NULL);
+		Skyroads::Benchmarks::Headless(ticks, seed);
+		return 0;
+	}
+
+	// Run a single game for a long time, and check that the entities stay in the reserved memory
+	// Usage: --soak [ticks] [seed]
+	if (argc > 1 && strcmp(argv[1], "--soak") == 0) {
+		unsigned long ticks = argc > 2 ? strtoul(argv[2], nullptr, 10) : 200000;
+		unsigned int seed = argc > 3 ? (unsigned int)strtoul(argv[3], nullptr, 10) : (unsigned int)time(NULL);
+		Skyroads::Benchmarks::Soak(ticks, seed);
+		return 0;
+	}
+
+	// Simulate a recorded game as fast as possible, without a window
+	// Usage: --replay <file> [repeats]
+	if (argc > 2 && strcmp(argv[1], "--replay") == 0) {
+		unsigned int repeats = argc > 3 ? (unsigned int)strtoul(argv[3], nullptr, 10) : 1;
+		Skyroads::Benchmarks::Replay(argv[2], repeats);
+		return 0;
+	}
+
+	// Compare the per-object and the batch physics integration
+	if (argc > 1 && strcmp(argv[1], "--bench-physics") == 0) {
+		Skyroads::Benchmarks::Physics();
+		return 0;
+	}
+
+	// Measure how the job system scales with the number of threads
+	if (argc > 1 && strcmp(argv[1], "--bench-jobs") == 0) {
+		Skyroads::Benchmarks::JobScaling();
+		return 0;
+	}
+
+	// Compare the sequential and the parallel texture decoding
+	if (argc > 1 && strcmp(argv[1], "--bench-textures") == 0) {
+		Skyroads::Benchmarks::TextureDecoding();
+		return 0;
+	}
+
+	// Compress the textures in .ktx files (loaded by the game instead of the images)
+	if (argc > 1 && strcmp(argv[1], "--bake-textures") == 0) {
+		Skyroads::Benchmarks::BakeTextures();
+		return 0;
+	}
+
+	// Bake the meshes in .mesh files (the game also does it when they are missing or outdated)
+	if (argc > 1 && strcmp(argv[1], "--bake-meshes") == 0) {
+		Skyroads::Benchmarks::BakeMeshes();
+		return 0;
+	}
 
 	// Create a window property structure
 	WindowProperties wp;
@@ -21,10 +78,17 @@ int main(int argc, char **argv)
 	WindowObject* window = Engine::Init(wp);
 
 	// Create a new 3D world and start running it
-	World *world = new Skyroads::GameManager();
+	// Usage: --record <file> (play the game and save its input, to replay it later)
+	Skyroads::GameManager *world = new Skyroads::GameManager();
+	if (argc > 2 && strcmp(argv[1], "--record") == 0) {
+		world->Record(argv[2]);
+	}
 	world->Init();
 	world->Run();
 
+	// Release the scene (this also finishes the recording, if the window was closed during a game)
+	delete world;
+
 	// Signals to the Engine to release the OpenGL context
 	Engine::Exit();
 
@@ -0,0 +1,452 @@
+#include "Benchmarks.hpp"
+
+#include <memory>
+#include <algorithm>
+#include <limits>
+#include <fstream>
+#include <stb/stb_image.h>
+
+#include "GameEngine/TextureLoader.hpp"
+#include "GameEngine/CompressedTexture.hpp"
+#include "GameEngine/BakedMesh.hpp"
+#include "GameEngine/JobSystem.hpp"
+#include "GameEngine/Frustum.hpp"
+#include "InputRecording.hpp"
+
+using namespace Skyroads;
+
+void Benchmarks::InitHeadlessResources()
+{
+	static std::unordered_map<std::string, Mesh*> meshes;
+	static std::unordered_map<std::string, Shader*> shaders;
+	static std::unordered_map<std::string, Texture2D*> textures;
+
+	GameEngine::GameObject::meshes = &meshes;
+	GameEngine::GameObject::shaders = &shaders;
+	GameEngine::GameObject::textures = &textures;
+}
+
+void Benchmarks::Headless(const unsigned long ticks, const unsigned int seed, const float deltaTime)
+{
+	InitHeadlessResources();
+
+	// Every game gets its own seed, generated from the seed of the run
+	GameEngine::Random seeds(seed);
+	std::unique_ptr<GameSimulation> simulation(new GameSimulation());
+	simulation->Init(seeds.Next());
+
+	unsigned long games = 0;
+	long long scoreSum = 0;
+	TickInput input;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned long tick = 0; tick < ticks; ++tick) {
+		simulation->Tick(input, deltaTime);
+
+		if (simulation->isGameOver()) {
+			games++;
+			scoreSum += simulation->getScore();
+
+			simulation.reset(new GameSimulation());
+			simulation->Init(seeds.Next());
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	double seconds = std::chrono::duration<double>(end - start).count();
+	std::cout << " --- Headless simulation --- " << "\n";
+	std::cout << " Ticks : " << ticks << " (dt = " << deltaTime << "s, seed " << seed << ")\n";
+	std::cout << " Time : " << seconds << "s\n";
+	std::cout << " Ticks per second : " << (seconds > 0 ? ticks / seconds : 0) << "\n";
+	std::cout << " Finished games : " << games;
+	if (games > 0) {
+		std::cout << " (average score " << scoreSum / (long long)games << ")";
+	}
+	std::cout << "\n";
+}
+
+void Benchmarks::Soak(const unsigned long ticks, const unsigned int seed)
+{
+	InitHeadlessResources();
+
+	const float deltaTime = (float)(1.0 / Constants::tickRate);
+	std::unique_ptr<GameSimulation> simulation(new GameSimulation());
+	simulation->Init(seed);
+
+	const GameEngine::EntityStore& entities = simulation->getEntities();
+	size_t capacity = entities.Capacity();
+	size_t minEntities = std::numeric_limits<size_t>::max();
+	size_t maxEntities = 0;
+	size_t maxPlatforms = 0;
+	bool platformsCounted = true;		// The platform count of the game state matches the platforms in the store
+	unsigned long gameOverTick = 0;
+	TickInput input;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (unsigned long tick = 0; tick < ticks; ++tick) {
+		simulation->Tick(input, deltaTime);
+		if (simulation->isGameOver() && gameOverTick == 0) {
+			gameOverTick = tick + 1;
+		}
+
+		minEntities = std::min(minEntities, entities.Count());
+		maxEntities = std::max(maxEntities, entities.Count());
+
+		size_t platforms = 0;
+		for (size_t i = 0; i < entities.Count(); ++i) {
+			if (entities.types[i].is(GameEngine::ObjectCategory::Platform)) {
+				platforms++;
+			}
+		}
+		maxPlatforms = std::max(maxPlatforms, platforms);
+		if ((int)platforms != simulation->getGameState().platformCount) {
+			platformsCounted = false;
+		}
+	}
+	auto end = std::chrono::high_resolution_clock::now();
+
+	bool flat = maxEntities <= capacity && entities.Capacity() == capacity;
+	double seconds = std::chrono::duration<double>(end - start).count();
+	std::cout << " --- Soak simulation --- " << "\n";
+	std::cout << " Ticks : " << ticks << " (dt = " << deltaTime << "s, seed " << seed << ")\n";
+	if (gameOverTick > 0) {
+		std::cout << " Game over at tick : " << gameOverTick << " (the simulation went on)\n";
+	}
+	std::cout << " Entities : " << minEntities << " - " << maxEntities << " (reserved " << capacity << ", at the end " << entities.Capacity() << ")\n";
+	std::cout << " Live platforms : at most " << maxPlatforms << " (limit " << Constants::maxPlatforms << ")"
+		<< (maxPlatforms <= (size_t)Constants::maxPlatforms ? "" : " - OVER THE LIMIT")
+		<< (platformsCounted ? "" : " - the platform count of the game state is WRONG") << "\n";
+	std::cout << " Memory : " << (flat ? "flat (no entity over the reserved capacity)" : "GREW past the reserved capacity") << "\n";
+	std::cout << " Time : " << seconds << "s\n";
+}
+
+void Benchmarks::Replay(const std::string& path, const unsigned int repeats)
+{
+	InputReplay replay;
+	if (!replay.Load(path)) return;
+
+	InitHeadlessResources();
+
+	std::cout << " --- Replay --- " << "\n";
+	std::cout << " Recording : " << path << " (" << replay.Ticks() << " ticks, seed " << replay.Seed() << ", dt = " << replay.DeltaTime() << "s)\n";
+
+	double totalSeconds = 0;
+	unsigned long long totalTicks = 0;
+	uint64_t firstHash = 0;
+	bool deterministic = true;
+
+	for (unsigned int repeat = 0; repeat < std::max(repeats, 1u); ++repeat) {
+		std::unique_ptr<GameSimulation> simulation(new GameSimulation());
+		simulation->Init(replay.Seed());
+
+		// The same input as in the recorded game, as fast as possible
+		size_t tick = 0;
+		auto start = std::chrono::high_resolution_clock::now();
+		while (tick < replay.Ticks() && !simulation->isGameOver()) {
+			simulation->Tick(replay.Input(tick), replay.DeltaTime());
+			tick++;
+		}
+		totalSeconds += std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+		totalTicks += tick;
+
+		uint64_t hash = simulation->StateHash();
+		if (repeat == 0) {
+			firstHash = hash;
+			std::cout << " Simulated ticks : " << tick << (simulation->isGameOver() ? " (game over)" : "") << "\n";
+			std::cout << " Score : " << simulation->getScore() << "\n";
+			std::cout << " State hash : " << std::hex << hash << std::dec << "\n";
+		}
+		else if (hash != firstHash) {
+			deterministic = false;
+		}
+	}
+
+	std::cout << " Repeats : " << std::max(repeats, 1u) << (deterministic ? " (same final state)" : " (DIFFERENT final states)") << "\n";
+	std::cout << " Time : " << totalSeconds << "s\n";
+	std::cout << " Ticks per second : " << (totalSeconds > 0 ? totalTicks / totalSeconds : 0) << "\n";
+}
+
+void Benchmarks::Physics()
+{
+	using namespace GameEngine;
+	using Clock = std::chrono::high_resolution_clock;
+
+	const float deltaTime = (float)(1.0 / Constants::tickRate);
+	const size_t bodyCounts[] = { 1000, 10000, 100000 };
+	const size_t steps = 60;			// One second of simulation, then the bodies are reset
+	const size_t bodySteps = 60000000;	// Number of (body, step) integrations for every test
+
+	// The same bodies are used on every run
+	Random random(1);
+
+	std::cout << " --- Physics integration --- " << "\n";
+	for (auto& count : bodyCounts) {
+		// Create some random bodies
+		std::vector<RigidBody> initial(count);
+		for (auto& body : initial) {
+			body.state.x = glm::vec3(random.Bounded(100), random.Bounded(100), random.Bounded(100));
+			body.state.v = glm::vec3(random.Range(-10, 10), random.Range(-10, 10), random.Range(-10, 10));
+			body.state.drag_coef = random.Bounded(100) / 10.f;
+			body.state.gravity_coef = random.Bounded(100) / 100.f;
+		}
+		size_t repeats = std::max<size_t>(1, bodySteps / (count * steps));
+
+		for (int mode = 0; mode < 2; ++mode) {
+			bool RK4 = mode == 0;
+			double perObject = 0, batched = 0, kernel = 0;
+			std::vector<RigidBody> bodies, batchBodies;
+			BodyBatch batch;
+
+			for (size_t repeat = 0; repeat < repeats; ++repeat) {
+				// Per-object integration
+				bodies = initial;
+				auto start = Clock::now();
+				for (size_t step = 0; step < steps; ++step) {
+					for (auto& body : bodies) {
+						PhysixEngine::integrate(body, 0, deltaTime, RK4);
+					}
+				}
+				perObject += std::chrono::duration<double>(Clock::now() - start).count();
+
+				// Batch integration (the bodies are gathered and stored back every step, like in the game)
+				batchBodies = initial;
+				start = Clock::now();
+				for (size_t step = 0; step < steps; ++step) {
+					batch.Resize(count);
+					for (size_t i = 0; i < count; ++i) {
+						batch.Load(i, batchBodies[i].state);
+					}
+					PhysixEngine::IntegrateBatch(batch, deltaTime, RK4);
+					for (size_t i = 0; i < count; ++i) {
+						batch.Store(i, batchBodies[i].state);
+					}
+				}
+				batched += std::chrono::duration<double>(Clock::now() - start).count();
+
+				// Batch integration only (the bodies stay in the batch)
+				batch.Resize(count);
+				for (size_t i = 0; i < count; ++i) {
+					batch.Load(i, initial[i].state);
+				}
+				start = Clock::now();
+				for (size_t step = 0; step < steps; ++step) {
+					PhysixEngine::IntegrateBatch(batch, deltaTime, RK4);
+				}
+				kernel += std::chrono::duration<double>(Clock::now() - start).count();
+			}
+
+			// The largest difference between the two methods
+			float maxError = 0;
+			for (size_t i = 0; i < count; ++i) {
+				maxError = std::max(maxError, glm::length(bodies[i].state.x - batchBodies[i].state.x));
+			}
+
+			double integrations = (double)repeats * steps * count;
+			std::cout << " " << count << " bodies, " << (RK4 ? "RK4" : "Euler") << "\n";
+			std::cout << "   per-object     : " << perObject * 1e9 / integrations << " ns/body\n";
+			std::cout << "   batch + copies : " << batched * 1e9 / integrations << " ns/body (x" << perObject / batched << ")\n";
+			std::cout << "   batch only     : " << kernel * 1e9 / integrations << " ns/body (x" << perObject / kernel << ")\n";
+			std::cout << "   max difference : " << maxError << "\n";
+		}
+	}
+}
+
+void Benchmarks::JobScaling()
+{
+	using namespace GameEngine;
+	using Clock = std::chrono::high_resolution_clock;
+
+	const size_t bodyCount = 1000000;
+	const size_t boxCount = 1000000;
+	const int steps = 30;
+	const size_t grain = 4096;		// A multiple of 8, like Constants::bodiesPerJob
+	const float deltaTime = (float)(1.0 / Constants::tickRate);
+
+	// The same bodies and boxes for every thread count
+	Random random(1);
+	BodyBatch initial;
+	initial.Resize(bodyCount);
+	for (size_t i = 0; i < bodyCount; ++i) {
+		State state;
+		state.x = glm::vec3(random.Bounded(100), random.Bounded(100), random.Bounded(100));
+		state.v = glm::vec3(random.Range(-10, 10), random.Range(-10, 10), random.Range(-10, 10));
+		state.drag_coef = random.Bounded(100) / 10.f;
+		state.gravity_coef = random.Bounded(100) / 100.f;
+		initial.Load(i, state);
+	}
+
+	std::vector<glm::vec3> boxes(boxCount);
+	for (auto& box : boxes) {
+		box = glm::vec3(random.Range(-100.f, 100.f), random.Range(-10.f, 10.f), random.Range(-100.f, 100.f));
+	}
+	Frustum frustum;
+	frustum.Extract(glm::perspective(RADIANS(75.f), 16.f / 9.f, 0.01f, 200.f) * glm::lookAt(glm::vec3(0, 5, 30), glm::vec3(0), glm::vec3(0, 1, 0)));
+	std::vector<unsigned char> visible(boxCount);
+
+	std::vector<unsigned int> threadCounts;
+	unsigned int maxThreads = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned int threads = 1; threads < maxThreads; threads *= 2) {
+		threadCounts.push_back(threads);
+	}
+	threadCounts.push_back(maxThreads);
+
+	std::cout << " --- Job system scaling --- " << "\n";
+	std::cout << " " << bodyCount << " bodies (RK4), " << boxCount << " boxes culled, blocks of " << grain << "\n";
+
+	double physicsBase = 0, cullingBase = 0;
+	BodyBatch reference;
+	for (auto& threads : threadCounts) {
+		JobSystem jobs(threads);
+		BodyBatch batch = initial;
+
+		auto start = Clock::now();
+		for (int step = 0; step < steps; ++step) {
+			jobs.ParallelFor(bodyCount, grain, [&batch, deltaTime](size_t begin, size_t end) {
+				PhysixEngine::IntegrateBatch(batch, begin, end, deltaTime);
+			});
+		}
+		double physics = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / steps;
+
+		size_t visibleCount = 0;
+		start = Clock::now();
+		for (int step = 0; step < steps; ++step) {
+			jobs.ParallelFor(boxCount, grain, [&boxes, &visible, &frustum](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; ++i) {
+					visible[i] = frustum.IsBoxVisible(boxes[i] - glm::vec3(1), boxes[i] + glm::vec3(1)) ? 1 : 0;
+				}
+			});
+		}
+		double culling = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / steps;
+		for (auto& flag : visible) visibleCount += flag;
+
+		// The results must not depend on the number of threads
+		bool same = true;
+		if (threads == threadCounts[0]) {
+			physicsBase = physics;
+			cullingBase = culling;
+			reference = batch;
+		}
+		else {
+			same = batch.px == reference.px && batch.py == reference.py && batch.pz == reference.pz;
+		}
+
+		std::cout << " " << threads << (threads == 1 ? " thread " : " threads") << " : physics " << physics << " ms (x" << physicsBase / physics
+			<< "), culling " << culling << " ms (x" << cullingBase / culling << ", " << visibleCount << " visible)"
+			<< (same ? "" : " - DIFFERENT RESULTS") << "\n";
+	}
+}
+
+void Benchmarks::TextureDecoding()
+{
+	using Clock = std::chrono::high_resolution_clock;
+	const int repeats = 5;
+
+	// The files loaded by the game
+	std::vector<std::pair<std::string, std::string>> files;
+	for (auto& name : Constants::textureNames) {
+		files.push_back(std::make_pair(name, "Source/src/Textures/" + name + ".png"));
+	}
+	for (auto& name : Constants::modelNames) {
+		files.push_back(std::make_pair(name, "Source/src/Models/" + name + ".png"));
+	}
+
+	double sequential = 0, parallel = 0;
+	unsigned int threads = 0;
+	size_t decoded = 0;
+
+	for (int repeat = 0; repeat < repeats; ++repeat) {
+		// One by one, on this thread
+		auto start = Clock::now();
+		decoded = 0;
+		for (auto& file : files) {
+			int width, height, channels;
+			unsigned char* data = stbi_load(file.second.c_str(), &width, &height, &channels, 0);
+			if (data != nullptr) {
+				decoded++;
+				stbi_image_free(data);
+			}
+		}
+		sequential += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+		// On the worker threads (starting the threads is part of the measured time)
+		start = Clock::now();
+		{
+			GameEngine::TextureLoader loader;
+			threads = loader.ThreadCount();
+			for (auto& file : files) {
+				loader.Add(file.first, file.second);
+			}
+
+			GameEngine::TextureLoader::Image image;
+			while (loader.Next(image)) {
+				GameEngine::TextureLoader::Free(image);
+			}
+		}
+		parallel += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	}
+
+	std::cout << " --- Texture decoding --- " << "\n";
+	std::cout << " Images : " << decoded << " of " << files.size() << "\n";
+	std::cout << " Sequential : " << sequential / repeats << " ms\n";
+	std::cout << " Parallel (" << threads << " threads) : " << parallel / repeats << " ms (x" << sequential / parallel << ")\n";
+}
+
+void Benchmarks::BakeTextures()
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	// The files loaded by the game
+	std::vector<std::pair<std::string, std::string>> files;
+	for (auto& name : Constants::textureNames) {
+		files.push_back(std::make_pair(name, "Source/src/Textures/" + name));
+	}
+	for (auto& name : Constants::modelNames) {
+		files.push_back(std::make_pair(name, "Source/src/Models/" + name));
+	}
+
+	std::cout << " --- Texture baking --- " << "\n";
+	auto start = Clock::now();
+	for (auto& file : files) {
+		std::string ktxPath = file.second + ".ktx";
+		if (!GameEngine::CompressedTexture::Bake(file.second + ".png", ktxPath)) {
+			std::cout << " " << file.first << " : failed\n";
+			continue;
+		}
+
+		int width, height, channels;
+		stbi_info((file.second + ".png").c_str(), &width, &height, &channels);
+		std::ifstream ktx(ktxPath, std::ios::binary | std::ios::ate);
+		double uncompressed = width * height * (channels == 4 ? 4 : 3) * 4.0 / 3.0;	// RGB8 / RGBA8, with the mipmaps
+		std::cout << " " << file.first << " : " << width << "x" << height << ", "
+			<< ktx.tellg() / 1024 << " KB (" << (long long)uncompressed / 1024 << " KB uncompressed)\n";
+	}
+	std::cout << " Time : " << std::chrono::duration<double>(Clock::now() - start).count() << "s\n";
+}
+
+void Benchmarks::BakeMeshes()
+{
+	using Clock = std::chrono::high_resolution_clock;
+
+	// The files loaded by the game
+	std::vector<std::pair<std::string, std::string>> files;
+	for (auto& name : Constants::meshNames) {
+		files.push_back(std::make_pair(name, std::string("Source/src/Meshes/")));
+	}
+	for (auto& name : Constants::modelNames) {
+		files.push_back(std::make_pair(name, std::string("Source/src/Models/")));
+	}
+
+	std::cout << " --- Mesh baking --- " << "\n";
+	auto start = Clock::now();
+	for (auto& file : files) {
+		if (!GameEngine::BakedMesh::Bake(file.second, file.first + ".obj", file.first + ".mesh")) {
+			std::cout << " " << file.first << " : failed\n";
+			continue;
+		}
+
+		std::ifstream obj(file.second + file.first + ".obj", std::ios::binary | std::ios::ate);
+		std::ifstream baked(file.second + file.first + ".mesh", std::ios::binary | std::ios::ate);
+		std::cout << " " << file.first << " : " << baked.tellg() / 1024 << " KB (" << obj.tellg() / 1024 << " KB .obj)\n";
+	}
+	std::cout << " Time : " << std::chrono::duration<double>(Clock::now() - start).count() << "s\n";
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <iostream>
+#include <chrono>
+#include <vector>
+#include <string>
+
+#include "GameSimulation.hpp"
+
+namespace Skyroads {
+	/// <summary>
+	/// Modes that run parts of the game without a window and print how fast they are
+	/// (and the offline tools used to prepare the assets).
+	/// They are selected from the command line (see Main.cpp).
+	/// </summary>
+	class Benchmarks {
+	public:
+		/// <summary>
+		/// Run the game logic for a number of ticks, without an OpenGL context or a window,
+		/// and print the number of ticks per second. When a game ends, a new one is started.
+		/// </summary>
+		/// <param name="ticks">The number of ticks to simulate</param>
+		/// <param name="seed">The seed of the run (the same seed simulates the same games)</param>
+		/// <param name="deltaTime">The duration of a tick, in seconds</param>
+		static void Headless(const unsigned long ticks, const unsigned int seed, const float deltaTime = (float)(1.0 / Constants::tickRate));
+
+		/// <summary>
+		/// Run a single game for a number of ticks, without starting a new one at game over (the
+		/// player keeps moving, so the track keeps being spawned and removed). Prints the range of the
+		/// entity count, and checks that it stays in the capacity reserved when the game started and
+		/// that there are never more than Constants::maxPlatforms platforms ahead of the player.
+		/// </summary>
+		/// <param name="ticks">The number of ticks to simulate</param>
+		/// <param name="seed">The seed of the game</param>
+		static void Soak(const unsigned long ticks, const unsigned int seed);
+
+		/// <summary>
+		/// Simulate a recorded game (see InputRecorder) without a window, as fast as possible, and print
+		/// the number of ticks per second and the final state. The game is simulated "repeats" times, and
+		/// the final states are compared, to check that the replay is deterministic.
+		/// </summary>
+		/// <param name="path">The recording file</param>
+		/// <param name="repeats">How many times the recording is simulated</param>
+		static void Replay(const std::string& path, const unsigned int repeats = 1);
+
+		/// <summary>
+		/// Compare the per-object physics integration with the batch (SIMD) integration,
+		/// for 1k, 10k and 100k bodies, using RK4 and semi-implicit Euler
+		/// </summary>
+		static void Physics();
+
+		/// <summary>
+		/// Run the batch physics integration (1M bodies) and the frustum culling (1M boxes) on the
+		/// job system, with 1, 2, 4, ... threads (up to the number of hardware threads), and print
+		/// the time of a step and the speedup compared to a single thread
+		/// </summary>
+		static void JobScaling();
+
+		/// <summary>
+		/// Compare the time needed to decode the textures of the game one by one
+		/// with the time needed to decode them on the worker threads of the TextureLoader
+		/// (only the decoding - there is no OpenGL context to upload them to)
+		/// </summary>
+		static void TextureDecoding();
+
+		/// <summary>
+		/// Compress the textures of the game (BC1 / BC3, with all the mip levels) in .ktx files,
+		/// next to the original images. The game loads them instead of the images, when they exist.
+		/// </summary>
+		static void BakeTextures();
+
+		/// <summary>
+		/// Bake the meshes and the models of the game in .mesh files, next to the .obj files.
+		/// The game also bakes them when it starts, if they are missing or outdated.
+		/// </summary>
+		static void BakeMeshes();
+
+	private:
+		Benchmarks();
+
+		/// <summary>
+		/// Link the game objects to empty resource maps. The meshes, shaders and textures will
+		/// be null, which is fine as long as nothing is rendered.
+		/// </summary>
+		static void InitHeadlessResources();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,294 @@
+#include "BakedMesh.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace {
+	/// <summary>
+	/// A file mapped in memory (read only). It is unmapped when the object is destroyed.
+	/// </summary>
+	class MappedFile {
+	public:
+		MappedFile(const std::string& path) : data(nullptr), size(0)
+		{
+#ifdef _WIN32
+			file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+			if (file == INVALID_HANDLE_VALUE) return;
+
+			LARGE_INTEGER fileSize;
+			if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) return;
+
+			mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+			if (mapping == NULL) return;
+
+			data = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			if (data != nullptr) size = (size_t)fileSize.QuadPart;
+#else
+			file = open(path.c_str(), O_RDONLY);
+			if (file < 0) return;
+
+			struct stat info;
+			if (fstat(file, &info) != 0 || info.st_size == 0) return;
+
+			void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+			if (view == MAP_FAILED) return;
+
+			data = (const uint8_t*)view;
+			size = (size_t)info.st_size;
+#endif
+		}
+
+		~MappedFile()
+		{
+#ifdef _WIN32
+			if (data != nullptr) UnmapViewOfFile(data);
+			if (mapping != NULL) CloseHandle(mapping);
+			if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+#else
+			if (data != nullptr) munmap((void*)data, size);
+			if (file >= 0) close(file);
+#endif
+		}
+
+		const uint8_t* data;
+		size_t size;
+
+	private:
+#ifdef _WIN32
+		HANDLE file = INVALID_HANDLE_VALUE;
+		HANDLE mapping = NULL;
+#else
+		int file = -1;
+#endif
+	};
+
+	/// <summary>
+	/// Add the content of a file to a FNV-1a hash
+	/// </summary>
+	/// <returns>If the file could be read</returns>
+	bool HashFile(const std::string& path, uint64_t& hash)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file) return false;
+
+		char buffer[4096];
+		while (file.read(buffer, sizeof(buffer)) || file.gcount() > 0) {
+			std::streamsize count = file.gcount();
+			for (std::streamsize i = 0; i < count; ++i) {
+				hash ^= (uint8_t)buffer[i];
+				hash *= 0x100000001B3ull;
+			}
+		}
+		return true;
+	}
+}
+
+GameEngine::BakedMesh::BakedMesh(std::string meshID) : Mesh(meshID) {}
+
+uint64_t GameEngine::BakedMesh::HashSource(const std::string& sourcePath)
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	if (!HashFile(sourcePath, hash)) return 0;
+
+	// The materials are part of the baked file too
+	size_t extension = sourcePath.find_last_of('.');
+	if (extension != std::string::npos) {
+		HashFile(sourcePath.substr(0, extension) + ".mtl", hash);
+	}
+	return hash;
+}
+
+bool GameEngine::BakedMesh::Bake(const std::string& fileLocation, const std::string& sourceName, const std::string& bakedName)
+{
+	std::string sourcePath = fileLocation + '/' + sourceName;
+	uint64_t sourceHash = HashSource(sourcePath);
+	if (sourceHash == 0) return false;
+
+	// Same import as Mesh::LoadMesh, for triangles
+	Assimp::Importer importer;
+	const aiScene* scene = importer.ReadFile(sourcePath, aiProcess_GenSmoothNormals | aiProcess_FlipUVs | aiProcess_Triangulate);
+	if (scene == nullptr) {
+		printf("Error parsing '%s': '%s'\n", sourcePath.c_str(), importer.GetErrorString());
+		return false;
+	}
+
+	std::vector<Vertex> vertices;
+	std::vector<uint16_t> indices;
+	std::vector<Entry> entries(scene->mNumMeshes);
+	std::vector<MaterialRecord> materialRecords(scene->mNumMaterials);
+
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i) {
+		const aiMesh* mesh = scene->mMeshes[i];
+		entries[i].nrIndices = mesh->mNumFaces * 3;
+		entries[i].baseVertex = (uint32_t)vertices.size();
+		entries[i].baseIndex = (uint32_t)indices.size();
+		entries[i].materialIndex = mesh->mMaterialIndex;
+
+		for (unsigned int v = 0; v < mesh->mNumVertices; ++v) {
+			Vertex vertex;
+			vertex.position = glm::vec3(mesh->mVertices[v].x, mesh->mVertices[v].y, mesh->mVertices[v].z);
+			vertex.normal = glm::vec3(mesh->mNormals[v].x, mesh->mNormals[v].y, mesh->mNormals[v].z);
+			vertex.texCoord = mesh->HasTextureCoords(0) ? glm::vec2(mesh->mTextureCoords[0][v].x, mesh->mTextureCoords[0][v].y) : glm::vec2(0);
+			vertices.push_back(vertex);
+		}
+
+		for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+			const aiFace& face = mesh->mFaces[f];
+			indices.push_back((uint16_t)face.mIndices[0]);
+			indices.push_back((uint16_t)face.mIndices[1]);
+			indices.push_back((uint16_t)face.mIndices[2]);
+		}
+	}
+
+	// The loaded meshes store the base vertex, the base index and the index count of their entries as
+	// unsigned shorts (Mesh::MeshEntry), and the indices are 16 bit values
+	if (vertices.size() > 0xFFFF) {
+		printf("Error baking '%s': too many vertices (%zu, at most %d)\n", sourcePath.c_str(), vertices.size(), 0xFFFF);
+		return false;
+	}
+	if (indices.size() > 0xFFFF) {
+		printf("Error baking '%s': too many indices (%zu, at most %d)\n", sourcePath.c_str(), indices.size(), 0xFFFF);
+		return false;
+	}
+
+	aiColor4D color;
+	for (unsigned int i = 0; i < scene->mNumMaterials; ++i) {
+		const aiMaterial* material = scene->mMaterials[i];
+		MaterialRecord& record = materialRecords[i];
+		record = MaterialRecord();
+
+		aiString path;
+		if (material->GetTextureCount(aiTextureType_DIFFUSE) > 0 &&
+			material->GetTexture(aiTextureType_DIFFUSE, 0, &path, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS) {
+			strncpy(record.texture, path.data, sizeof(record.texture) - 1);
+		}
+
+		if (aiGetMaterialColor(material, AI_MATKEY_COLOR_AMBIENT, &color) == AI_SUCCESS)
+			record.ambient = glm::vec4(color.r, color.g, color.b, color.a);
+
+		if (aiGetMaterialColor(material, AI_MATKEY_COLOR_DIFFUSE, &color) == AI_SUCCESS)
+			record.diffuse = glm::vec4(color.r, color.g, color.b, color.a);
+
+		if (aiGetMaterialColor(material, AI_MATKEY_COLOR_SPECULAR, &color) == AI_SUCCESS)
+			record.specular = glm::vec4(color.r, color.g, color.b, color.a);
+
+		if (aiGetMaterialColor(material, AI_MATKEY_COLOR_EMISSIVE, &color) == AI_SUCCESS)
+			record.emissive = glm::vec4(color.r, color.g, color.b, color.a);
+	}
+
+	// Keep the entries and the materials aligned to 4 bytes
+	if (indices.size() % 2 == 1) {
+		indices.push_back(0);
+	}
+
+	Header header = {};
+	header.magic = magic;
+	header.version = version;
+	header.sourceHash = sourceHash;
+	header.drawMode = GL_TRIANGLES;
+	header.vertexCount = (uint32_t)vertices.size();
+	header.indexCount = (uint32_t)indices.size();
+	header.entryCount = (uint32_t)entries.size();
+	header.materialCount = (uint32_t)materialRecords.size();
+
+	std::ofstream file(fileLocation + '/' + bakedName, std::ios::binary);
+	if (!file) return false;
+
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)vertices.data(), vertices.size() * sizeof(Vertex));
+	file.write((const char*)indices.data(), indices.size() * sizeof(uint16_t));
+	file.write((const char*)entries.data(), entries.size() * sizeof(Entry));
+	file.write((const char*)materialRecords.data(), materialRecords.size() * sizeof(MaterialRecord));
+	return (bool)file;
+}
+
+bool GameEngine::BakedMesh::LoadBaked(const std::string& fileLocation, const std::string& sourceName, const std::string& bakedName)
+{
+	MappedFile file(fileLocation + '/' + bakedName);
+	if (file.data == nullptr || file.size < sizeof(Header)) return false;
+
+	const Header* header = (const Header*)file.data;
+	if (header->magic != magic || header->version != version || header->drawMode != glDrawMode) return false;
+
+	size_t verticesSize = header->vertexCount * sizeof(Vertex);
+	size_t indicesSize = header->indexCount * sizeof(uint16_t);
+	size_t entriesSize = header->entryCount * sizeof(Entry);
+	size_t materialsSize = header->materialCount * sizeof(MaterialRecord);
+	if (file.size != sizeof(Header) + verticesSize + indicesSize + entriesSize + materialsSize) return false;
+
+	// The model changed since the file was baked
+	if (header->sourceHash != HashSource(fileLocation + '/' + sourceName)) return false;
+
+	const uint8_t* vertexData = file.data + sizeof(Header);
+	const uint16_t* indexData = (const uint16_t*)(vertexData + verticesSize);
+	const Entry* entryData = (const Entry*)((const uint8_t*)indexData + indicesSize);
+	const MaterialRecord* materialData = (const MaterialRecord*)((const uint8_t*)entryData + entriesSize);
+
+	ClearData();
+	this->fileLocation = fileLocation;
+
+	// The indices are kept on the CPU too, like for the other meshes
+	indices.assign(indexData, indexData + header->indexCount);
+
+	meshEntries.resize(header->entryCount);
+	for (uint32_t i = 0; i < header->entryCount; ++i) {
+		meshEntries[i].nrIndices = (unsigned short)entryData[i].nrIndices;
+		meshEntries[i].baseVertex = (unsigned short)entryData[i].baseVertex;
+		meshEntries[i].baseIndex = (unsigned short)entryData[i].baseIndex;
+		meshEntries[i].materialIndex = entryData[i].materialIndex;
+	}
+
+	if (useMaterial) {
+		materials.resize(header->materialCount);
+		for (uint32_t i = 0; i < header->materialCount; ++i) {
+			const MaterialRecord& record = materialData[i];
+			materials[i] = new Material();
+			materials[i]->ambient = record.ambient;
+			materials[i]->diffuse = record.diffuse;
+			materials[i]->specular = record.specular;
+			materials[i]->emissive = record.emissive;
+
+			if (record.texture[0] != '\0') {
+				materials[i]->texture = TextureManager::LoadTexture(fileLocation, record.texture);
+			}
+		}
+	}
+
+	// Upload the interleaved vertices and the indices directly from the mapped file
+	buffers->ReleaseMemory();
+	buffers->CreateBuffers(2);
+	glBindVertexArray(buffers->VAO);
+
+	glBindBuffer(GL_ARRAY_BUFFER, buffers->VBO[0]);
+	glBufferData(GL_ARRAY_BUFFER, verticesSize, vertexData, GL_STATIC_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
+
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, buffers->VBO[1]);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indicesSize, indexData, GL_STATIC_DRAW);
+
+	// Make sure the VAO is not changed from the outside
+	glBindVertexArray(0);
+	CheckOpenGLError();
+
+	return buffers->VAO != 0;
+}
\ No newline at end of file
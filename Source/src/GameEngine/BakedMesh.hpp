@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include <Core/Engine.h>
+
+namespace GameEngine {
+	/// <summary>
+	/// A mesh loaded from a binary file created from an .obj file (Bake). The file contains the
+	/// interleaved vertices (position, normal, texture coordinates), the indices, the mesh entries
+	/// and the materials, in the layout they are used at runtime. Loading it (LoadBaked) means mapping
+	/// the file and uploading the vertices and indices directly, without running the Assimp importer.
+	/// The file stores the hash of the source files, so an outdated file is detected and ignored.
+	/// </summary>
+	class BakedMesh : public Mesh {
+	public:
+		BakedMesh(std::string meshID);
+
+		/// <summary>
+		/// Create a baked mesh file from a model file, using Assimp (the same way Mesh::LoadMesh does).
+		/// It doesn't need an OpenGL context.
+		/// </summary>
+		/// <param name="fileLocation">The directory of the model (and of the baked file)</param>
+		/// <param name="sourceName">The model file (.obj)</param>
+		/// <param name="bakedName">The baked file that is created</param>
+		/// <returns>If the file was created</returns>
+		static bool Bake(const std::string& fileLocation, const std::string& sourceName, const std::string& bakedName);
+
+		/// <summary>
+		/// Load the mesh from a baked file. Must be called from the thread with the OpenGL context.
+		/// </summary>
+		/// <param name="fileLocation">The directory of the model (and of the baked file)</param>
+		/// <param name="sourceName">The model file the baked file was created from</param>
+		/// <param name="bakedName">The baked file</param>
+		/// <returns>If the mesh was loaded (false if the file doesn't exist, is invalid or outdated)</returns>
+		bool LoadBaked(const std::string& fileLocation, const std::string& sourceName, const std::string& bakedName);
+
+		/// <summary>
+		/// Compute the hash of a model file and of its material library (the .mtl file with the same name)
+		/// </summary>
+		/// <param name="sourcePath">The model file</param>
+		/// <returns>The hash (FNV-1a, 64 bits), or 0 if the file couldn't be read</returns>
+		static uint64_t HashSource(const std::string& sourcePath);
+
+	private:
+		static const uint32_t magic = 0x4853454D;	// "MESH"
+		static const uint32_t version = 1;
+
+		struct Header {
+			uint32_t magic;
+			uint32_t version;
+			uint64_t sourceHash;
+			uint32_t drawMode;
+			uint32_t vertexCount;
+			uint32_t indexCount;		// Padded to an even number, so the next sections stay aligned
+			uint32_t entryCount;
+			uint32_t materialCount;
+			uint32_t padding;
+		};
+
+		struct Vertex {
+			glm::vec3 position;
+			glm::vec3 normal;
+			glm::vec2 texCoord;
+		};
+
+		struct Entry {
+			uint32_t nrIndices;
+			uint32_t baseVertex;
+			uint32_t baseIndex;
+			uint32_t materialIndex;
+		};
+
+		struct MaterialRecord {
+			glm::vec4 ambient;
+			glm::vec4 diffuse;
+			glm::vec4 specular;
+			glm::vec4 emissive;
+			char texture[128];		// The diffuse texture, relative to the model directory (empty if none)
+		};
+	};
+}
\ No newline at end of file
@@ -0,0 +1,92 @@
+#include "BloomRenderer.hpp"
+
+GameEngine::BloomRenderer::BloomRenderer() : framebuffer(0) {}
+
+void GameEngine::BloomRenderer::Init(const glm::ivec2 resolution)
+{
+	glGenFramebuffers(1, &framebuffer);
+
+	glm::ivec2 size = resolution;
+	for (unsigned int i = 0; i < maxLevels; ++i) {
+		size /= 2;
+		if (size.x < 2 || size.y < 2) break;
+
+		Level level;
+		level.size = size;
+		glGenTextures(1, &level.texture);
+		glBindTexture(GL_TEXTURE_2D, level.texture);
+
+		// The bloom doesn't need alpha or the precision of the scene
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_R11F_G11F_B10F, size.x, size.y, 0, GL_RGB, GL_FLOAT, NULL);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+		levels.push_back(level);
+	}
+	glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+void GameEngine::BloomRenderer::Delete()
+{
+	for (auto& level : levels) {
+		glDeleteTextures(1, &level.texture);
+	}
+	levels.clear();
+
+	if (framebuffer != 0) {
+		glDeleteFramebuffers(1, &framebuffer);
+		framebuffer = 0;
+	}
+}
+
+GLuint GameEngine::BloomRenderer::Render(const GLuint sceneTexture, Shader* downsample, Shader* upsample, Mesh* quad, const float threshold)
+{
+	if (levels.empty()) return 0;
+
+	glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+	glBindVertexArray(quad->GetBuffers()->VAO);
+	glActiveTexture(GL_TEXTURE0);
+	GLsizei indices = static_cast<GLsizei>(quad->indices.size());
+
+	// -- Downsample, from the scene to the smallest level --
+	glUseProgram(downsample->program);
+	glUniform1i(downsample->GetCachedUniformLocation("image"), 0);
+	glUniform1f(downsample->GetCachedUniformLocation("threshold"), threshold);
+
+	GLuint source = sceneTexture;
+	for (size_t i = 0; i < levels.size(); ++i) {
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, levels[i].texture, 0);
+		glViewport(0, 0, levels[i].size.x, levels[i].size.y);
+
+		// The bright parts are extracted in the first pass
+		glUniform1i(downsample->GetCachedUniformLocation("bright_pass"), i == 0);
+		glBindTexture(GL_TEXTURE_2D, source);
+		glDrawElements(quad->GetDrawMode(), indices, GL_UNSIGNED_SHORT, 0);
+
+		source = levels[i].texture;
+	}
+
+	// -- Upsample, adding every level to the next larger one --
+	glUseProgram(upsample->program);
+	glUniform1i(upsample->GetCachedUniformLocation("image"), 0);
+	glUniform1f(upsample->GetCachedUniformLocation("filter_radius"), 1.f);
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_ONE, GL_ONE);
+	glBlendEquation(GL_FUNC_ADD);
+
+	for (size_t i = levels.size() - 1; i > 0; --i) {
+		glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, levels[i - 1].texture, 0);
+		glViewport(0, 0, levels[i - 1].size.x, levels[i - 1].size.y);
+
+		glBindTexture(GL_TEXTURE_2D, levels[i].texture);
+		glDrawElements(quad->GetDrawMode(), indices, GL_UNSIGNED_SHORT, 0);
+	}
+
+	glDisable(GL_BLEND);
+	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+	return levels[0].texture;
+}
\ No newline at end of file
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+
+#include <Core/Engine.h>
+
+namespace GameEngine {
+	/// <summary>
+	/// Bloom computed over a chain of progressively smaller textures (each one half the size
+	/// of the previous). The scene is downsampled level by level (the first downsample also
+	/// keeps only the bright parts of the image), then the levels are upsampled back and added
+	/// together. Most of the work is done on small textures, so it is a lot cheaper than
+	/// blurring at full resolution, and the blur radius is much wider.
+	/// </summary>
+	class BloomRenderer {
+	public:
+		/// <summary>
+		/// The maximum number of levels in the chain
+		/// </summary>
+		static const unsigned int maxLevels = 6;
+
+		BloomRenderer();
+
+		/// <summary>
+		/// Create the textures of the chain
+		/// </summary>
+		/// <param name="resolution">The size of the scene (the first level is half of it)</param>
+		void Init(const glm::ivec2 resolution);
+
+		/// <summary>
+		/// Delete the textures of the chain
+		/// </summary>
+		void Delete();
+
+		/// <summary>
+		/// Compute the bloom of a scene
+		/// </summary>
+		/// <param name="sceneTexture">The HDR color of the scene</param>
+		/// <param name="downsample">The downsample (and bright-pass) shader</param>
+		/// <param name="upsample">The upsample shader</param>
+		/// <param name="quad">A screen quad</param>
+		/// <param name="threshold">The brightness above which a color contributes to the bloom</param>
+		/// <returns>The texture with the bloom (half the size of the scene)</returns>
+		GLuint Render(const GLuint sceneTexture, Shader* downsample, Shader* upsample, Mesh* quad, const float threshold);
+
+	private:
+		struct Level {
+			glm::ivec2 size;
+			GLuint texture;
+		};
+
+		std::vector<Level> levels;
+		GLuint framebuffer;
+	};
+}
\ No newline at end of file
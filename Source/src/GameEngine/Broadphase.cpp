@@ -0,0 +1,95 @@
+#include "Broadphase.hpp"
+
+#include <algorithm>
+
+void GameEngine::Broadphase::SortAxis()
+{
+	// Insertion sort - the list is almost sorted from the last frame
+	for (size_t i = 1; i < order.size(); ++i) {
+		unsigned int id = order[i];
+		float key = proxies[id].min.z;
+
+		size_t j = i;
+		while (j > 0 && proxies[order[j - 1]].min.z > key) {
+			order[j] = order[j - 1];
+			j--;
+		}
+		order[j] = id;
+	}
+}
+
+void GameEngine::Broadphase::Insert(const unsigned int id, const Collider& collider)
+{
+	if (id >= proxies.size()) {
+		proxies.resize(id + 1);
+	}
+
+	Proxy& proxy = proxies[id];
+	collider.getBounds(proxy.min, proxy.max);
+	if (!proxy.active) {
+		proxy.active = true;
+		order.push_back(id);
+	}
+}
+
+void GameEngine::Broadphase::Update(const unsigned int id, const Collider& collider)
+{
+	if (!Contains(id)) return;
+	collider.getBounds(proxies[id].min, proxies[id].max);
+}
+
+void GameEngine::Broadphase::Remove(const unsigned int id)
+{
+	if (!Contains(id)) return;
+
+	proxies[id].active = false;
+	order.erase(std::find(order.begin(), order.end(), id));
+}
+
+bool GameEngine::Broadphase::Contains(const unsigned int id) const
+{
+	return id < proxies.size() && proxies[id].active;
+}
+
+void GameEngine::Broadphase::FindPairs(std::vector<std::pair<unsigned int, unsigned int>>& pairs)
+{
+	pairs.clear();
+	SortAxis();
+
+	// Sweep along the Z axis, keeping a list with the proxies that may still overlap
+	sweepList.clear();
+	for (auto& id : order) {
+		const Proxy& current = proxies[id];
+
+		size_t kept = 0;
+		for (size_t i = 0; i < sweepList.size(); ++i) {
+			const Proxy& other = proxies[sweepList[i]];
+
+			// The other proxy ends before this one starts, so it can't overlap any of the next ones
+			if (other.max.z < current.min.z) continue;
+			sweepList[kept++] = sweepList[i];
+
+			// Overlapping on the Z axis, check the other two
+			if (other.min.x <= current.max.x && other.max.x >= current.min.x &&
+				other.min.y <= current.max.y && other.max.y >= current.min.y) {
+				pairs.push_back(std::make_pair(sweepList[i], id));
+			}
+		}
+		sweepList.resize(kept);
+		sweepList.push_back(id);
+	}
+}
+
+void GameEngine::Broadphase::Clear()
+{
+	proxies.clear();
+	order.clear();
+	sweepList.clear();
+}
+
+void GameEngine::Broadphase::Reserve(const size_t capacity)
+{
+	proxies.reserve(capacity);
+	order.reserve(capacity);
+	sweepList.reserve(capacity);
+}
\ No newline at end of file
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+
+#include "Colliders.hpp"
+
+namespace GameEngine {
+	/// <summary>
+	/// Broadphase collision detection, using sweep-and-prune along the Z axis (the direction
+	/// the player is moving). The bounds of the colliders are kept in a list sorted by their
+	/// minimum Z. Because objects move only a little between frames, the list is almost sorted
+	/// every time and an insertion sort restores the order in close to linear time. The sweep
+	/// then returns only the pairs whose bounds overlap, so the narrow-phase
+	/// (CollisionManager::isCollision) runs on a few pairs instead of every object.
+	/// </summary>
+	class Broadphase {
+	private:
+		struct Proxy {
+			glm::vec3 min = glm::vec3(0);
+			glm::vec3 max = glm::vec3(0);
+			bool active = false;
+		};
+
+		std::vector<Proxy> proxies;		// Indexed by the id of the proxy
+		std::vector<unsigned int> order;	// The ids of the active proxies, sorted by min.z
+		std::vector<unsigned int> sweepList;	// Reused between sweeps
+
+		/// <summary>
+		/// Restore the order of the proxies, by their minimum Z
+		/// </summary>
+		void SortAxis();
+
+	public:
+		/// <summary>
+		/// Add a collider to the broadphase
+		/// </summary>
+		/// <param name="id">The id used to reference the collider (it must be unique)</param>
+		/// <param name="collider">The collider</param>
+		void Insert(const unsigned int id, const Collider& collider);
+
+		/// <summary>
+		/// Update the bounds of a collider that moved
+		/// </summary>
+		/// <param name="id">The id of the collider</param>
+		/// <param name="collider">The collider</param>
+		void Update(const unsigned int id, const Collider& collider);
+
+		/// <summary>
+		/// Remove a collider from the broadphase
+		/// </summary>
+		/// <param name="id">The id of the collider</param>
+		void Remove(const unsigned int id);
+
+		/// <summary>
+		/// Check if an id is part of the broadphase
+		/// </summary>
+		/// <param name="id">The id</param>
+		/// <returns>If it was inserted (and not removed)</returns>
+		bool Contains(const unsigned int id) const;
+
+		/// <summary>
+		/// Find all the pairs of colliders whose bounds overlap
+		/// </summary>
+		/// <param name="pairs">The vector where the pairs of ids will be stored (it is cleared first)</param>
+		void FindPairs(std::vector<std::pair<unsigned int, unsigned int>>& pairs);
+
+		/// <summary>
+		/// Remove all the colliders
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Reserve space for a number of colliders, so inserting them doesn't allocate memory
+		/// </summary>
+		/// <param name="capacity">The maximum id + 1</param>
+		void Reserve(const size_t capacity);
+	};
+}
\ No newline at end of file
@@ -78,4 +78,18 @@ double GameEngine::Collider::getRadius() const
 void GameEngine::Collider::setRadius(const double rad)
 {
     radius = rad;
+}
+
+void GameEngine::Collider::getBounds(glm::vec3& min, glm::vec3& max) const
+{
+    glm::vec3 halfSize;
+    if (type == ColliderType::BoxCollider) {
+        halfSize = dimensions * 0.5f;
+    }
+    else {
+        halfSize = glm::vec3((float)radius);
+    }
+
+    min = position - halfSize;
+    max = position + halfSize;
 }
\ No newline at end of file
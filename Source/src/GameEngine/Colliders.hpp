@@ -23,6 +23,9 @@ namespace GameEngine {
         // Copy Constructor
         Collider(const Collider& other);
 
+        // Copy Assignment (the colliders are stored by value, in the entity arrays)
+        Collider& operator=(const Collider& other) = default;
+
         /// <summary>
         /// Create a new box collider, with a specific dimensions, linked to a gameObject with a specific id
         /// </summary>
@@ -99,5 +102,12 @@ namespace GameEngine {
         /// </summary>
         /// <param name="rad">The new radius</param>
         void setRadius(const double radius);
+
+        /// <summary>
+        /// Get the axis-aligned bounds of the collider
+        /// </summary>
+        /// <param name="min">The minimum corner</param>
+        /// <param name="max">The maximum corner</param>
+        void getBounds(glm::vec3& min, glm::vec3& max) const;
     };
 }
\ No newline at end of file
@@ -12,8 +12,15 @@ namespace GameEngine {
 		/// <param name="others">An vector with the colliders of all the other objects</param>
 		/// <returns>An array with the id's of all the objects this one collided with</returns>
 		static std::vector<int> getCollisions(const Collider& source, std::vector<Collider*> others);
+
+		/// <summary>
+		/// Check if two colliders intersect
+		/// </summary>
+		/// <param name="a">The first collider</param>
+		/// <param name="b">The second collider</param>
+		/// <returns>If there is a collision</returns>
+		static bool isCollision(const Collider& a, const Collider& b);
 	private:
 		CollisionManager();
-		static bool isCollision(const Collider& a, const Collider& b);
 	};
 }
\ No newline at end of file
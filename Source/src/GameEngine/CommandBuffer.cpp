@@ -0,0 +1,52 @@
+#include "CommandBuffer.hpp"
+
+GameEngine::CommandBuffer::CommandBuffer() : visibleObjects(0), culledObjects(0) {}
+
+void GameEngine::CommandBuffer::Clear()
+{
+	draws.clear();
+	instances.clear();
+	visibleObjects = 0;
+	culledObjects = 0;
+}
+
+void GameEngine::CommandBuffer::Record(const TransformComponent& transform, const RenderComponent& render,
+	const glm::vec3& eyePosition, const glm::vec3& viewDirection, const InstancedRenderer& instancing)
+{
+	visibleObjects++;
+	if (render.mesh == nullptr || render.shader == nullptr || !render.isRendered) return;
+
+	Shader* instancedShader = instancing.GetInstancedShader(render);
+	if (instancedShader != nullptr) {
+		InstanceCommand command;
+		command.mesh = render.mesh;
+		command.shader = instancedShader;
+		command.texture = render.hasTexture ? render.texture : nullptr;
+		command.instance = InstancedRenderer::MakeInstance(transform, render);
+		instances.push_back(command);
+		return;
+	}
+
+	DrawCommand command;
+	if (RenderQueue::Record(RenderPass::Opaque, transform, render, eyePosition, viewDirection, command)) {
+		draws.push_back(command);
+	}
+}
+
+void GameEngine::CommandBuffer::Cull()
+{
+	culledObjects++;
+}
+
+void GameEngine::CommandBuffer::Submit(RenderQueue& queue, InstancedRenderer& instancing, RenderStats& stats) const
+{
+	for (auto& command : instances) {
+		instancing.Add(command.mesh, command.shader, command.texture, command.instance);
+	}
+	for (auto& command : draws) {
+		queue.Submit(command);
+	}
+
+	stats.visibleObjects += visibleObjects;
+	stats.culledObjects += culledObjects;
+}
\ No newline at end of file
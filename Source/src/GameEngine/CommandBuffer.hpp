@@ -0,0 +1,61 @@
+#pragma once
+
+#include <vector>
+
+#include "RenderQueue.hpp"
+#include "InstancedRenderer.hpp"
+
+namespace GameEngine {
+	/// <summary>
+	/// The draws of a part of the scene, recorded without any OpenGL call. Every thread that
+	/// prepares the scene records in its own buffer (the model matrices, sort keys, materials
+	/// and instance data are all computed there), and the thread with the OpenGL context only
+	/// submits the recorded commands to the renderers. The memory is kept between frames.
+	/// </summary>
+	class CommandBuffer {
+	public:
+		CommandBuffer();
+
+		/// <summary>
+		/// Remove the recorded commands
+		/// </summary>
+		void Clear();
+
+		/// <summary>
+		/// Record the draw of a visible object. It is instanced, if its shader has an instanced version.
+		/// </summary>
+		/// <param name="transform">The transform the object is rendered with</param>
+		/// <param name="render">The render data of the object (it must be valid until the frame is rendered)</param>
+		/// <param name="eyePosition">The position of the camera</param>
+		/// <param name="viewDirection">The direction the camera looks at</param>
+		/// <param name="instancing">The renderer of the instanced objects (only read)</param>
+		void Record(const TransformComponent& transform, const RenderComponent& render,
+			const glm::vec3& eyePosition, const glm::vec3& viewDirection, const InstancedRenderer& instancing);
+
+		/// <summary>
+		/// Count an object that was culled
+		/// </summary>
+		void Cull();
+
+		/// <summary>
+		/// Add the recorded commands to the renderers. Must be called from the thread with the OpenGL context.
+		/// </summary>
+		/// <param name="queue">The queue of the draws that are not instanced</param>
+		/// <param name="instancing">The renderer of the instanced objects</param>
+		/// <param name="stats">The stats where the visible and culled objects are added</param>
+		void Submit(RenderQueue& queue, InstancedRenderer& instancing, RenderStats& stats) const;
+
+	private:
+		struct InstanceCommand {
+			Mesh* mesh;
+			Shader* shader;		// The instanced shader
+			Texture2D* texture;
+			InstanceData instance;
+		};
+
+		std::vector<DrawCommand> draws;
+		std::vector<InstanceCommand> instances;
+		unsigned int visibleObjects;
+		unsigned int culledObjects;
+	};
+}
\ No newline at end of file
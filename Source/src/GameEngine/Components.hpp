@@ -0,0 +1,42 @@
+#pragma once
+
+#include <Core/Engine.h>
+#include "Lighting.hpp"
+
+namespace GameEngine {
+	/// <summary>
+	/// The position and the scale of an object
+	/// </summary>
+	struct TransformComponent {
+		glm::vec3 position = glm::vec3(0);
+		glm::vec3 scale = glm::vec3(1);
+
+		/// <summary>
+		/// The position at the previous simulation tick (used to interpolate the rendered position)
+		/// </summary>
+		glm::vec3 previousPosition = glm::vec3(0);
+	};
+
+	/// <summary>
+	/// All the data needed to draw an object (mesh, shader, textures, material)
+	/// </summary>
+	struct RenderComponent {
+		Mesh* mesh = nullptr;
+		Shader* shader = nullptr;
+		Texture2D* texture = nullptr;
+
+		/// <summary>
+		/// Additional emission maps (the window and exhaust maps of the spaceship)
+		/// </summary>
+		Texture2D* emissionMaps[2] = { nullptr, nullptr };
+
+		Material material = {};
+		bool hasTexture = false;
+		bool isRendered = true;
+
+		/// <summary>
+		/// How much the object must be in a distorted state (specifically, the player)
+		/// </summary>
+		double distortedTime = 0;
+	};
+}
@@ -0,0 +1,306 @@
+#include "CompressedTexture.hpp"
+
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+#include <stb/stb_image.h>
+
+namespace {
+	// The header of a KTX (version 1) file
+	struct KtxHeader {
+		uint8_t identifier[12];
+		uint32_t endianness;
+		uint32_t glType;
+		uint32_t glTypeSize;
+		uint32_t glFormat;
+		uint32_t glInternalFormat;
+		uint32_t glBaseInternalFormat;
+		uint32_t pixelWidth;
+		uint32_t pixelHeight;
+		uint32_t pixelDepth;
+		uint32_t numberOfArrayElements;
+		uint32_t numberOfFaces;
+		uint32_t numberOfMipmapLevels;
+		uint32_t bytesOfKeyValueData;
+	};
+
+	const uint8_t ktxIdentifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+	const uint32_t ktxEndianness = 0x04030201;
+
+	uint16_t PackRGB565(const int r, const int g, const int b)
+	{
+		return (uint16_t)(((r >> 3) << 11) | ((g >> 2) << 5) | (b >> 3));
+	}
+
+	void UnpackRGB565(const uint16_t color, int* rgb)
+	{
+		// Replicate the high bits in the low ones, like the GPU does
+		int r = (color >> 11) & 31, g = (color >> 5) & 63, b = color & 31;
+		rgb[0] = (r << 3) | (r >> 2);
+		rgb[1] = (g << 2) | (g >> 4);
+		rgb[2] = (b << 3) | (b >> 2);
+	}
+}
+
+void GameEngine::CompressedTexture::CompressBC1(const uint8_t* pixels, uint8_t* block)
+{
+	// The endpoints are the corners of the bounding box of the colors, moved a little inside
+	// (the colors at the ends of the box are rarely used as they are)
+	int min[3] = { 255, 255, 255 }, max[3] = { 0, 0, 0 };
+	for (int i = 0; i < 16; ++i) {
+		for (int c = 0; c < 3; ++c) {
+			min[c] = std::min(min[c], (int)pixels[i * 4 + c]);
+			max[c] = std::max(max[c], (int)pixels[i * 4 + c]);
+		}
+	}
+	for (int c = 0; c < 3; ++c) {
+		int inset = (max[c] - min[c]) >> 4;
+		min[c] = std::min(255, min[c] + inset);
+		max[c] = std::max(0, max[c] - inset);
+	}
+
+	uint16_t color0 = PackRGB565(max[0], max[1], max[2]);
+	uint16_t color1 = PackRGB565(min[0], min[1], min[2]);
+
+	// The 4 color mode is used only if color0 > color1
+	if (color0 < color1) {
+		std::swap(color0, color1);
+	}
+
+	// The colors of the palette: the endpoints, and two colors between them
+	int palette[4][3];
+	UnpackRGB565(color0, palette[0]);
+	UnpackRGB565(color1, palette[1]);
+	for (int c = 0; c < 3; ++c) {
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+
+	uint32_t indices = 0;
+	if (color0 != color1) {
+		for (int i = 0; i < 16; ++i) {
+			int best = 0, bestDistance = INT32_MAX;
+			for (int p = 0; p < 4; ++p) {
+				int distance = 0;
+				for (int c = 0; c < 3; ++c) {
+					int diff = (int)pixels[i * 4 + c] - palette[p][c];
+					distance += diff * diff;
+				}
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			indices |= (uint32_t)best << (i * 2);
+		}
+	}
+
+	block[0] = color0 & 0xFF;
+	block[1] = color0 >> 8;
+	block[2] = color1 & 0xFF;
+	block[3] = color1 >> 8;
+	memcpy(block + 4, &indices, 4);
+}
+
+void GameEngine::CompressedTexture::CompressBC3(const uint8_t* pixels, uint8_t* block)
+{
+	// -- The alpha block: two endpoints and 6 values between them --
+	int alpha0 = 0, alpha1 = 255;
+	for (int i = 0; i < 16; ++i) {
+		alpha0 = std::max(alpha0, (int)pixels[i * 4 + 3]);
+		alpha1 = std::min(alpha1, (int)pixels[i * 4 + 3]);
+	}
+
+	uint64_t alphaIndices = 0;
+	if (alpha0 != alpha1) {
+		int palette[8] = { alpha0, alpha1 };
+		for (int p = 1; p < 7; ++p) {
+			palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+		}
+
+		for (int i = 0; i < 16; ++i) {
+			int best = 0, bestDistance = INT32_MAX;
+			for (int p = 0; p < 8; ++p) {
+				int distance = std::abs((int)pixels[i * 4 + 3] - palette[p]);
+				if (distance < bestDistance) {
+					bestDistance = distance;
+					best = p;
+				}
+			}
+			alphaIndices |= (uint64_t)best << (i * 3);
+		}
+	}
+
+	block[0] = (uint8_t)alpha0;
+	block[1] = (uint8_t)alpha1;
+	for (int i = 0; i < 6; ++i) {
+		block[2 + i] = (uint8_t)(alphaIndices >> (i * 8));
+	}
+
+	// -- The color block, like BC1 --
+	CompressBC1(pixels, block + 8);
+}
+
+std::vector<uint8_t> GameEngine::CompressedTexture::CompressImage(const std::vector<uint8_t>& image, const int width, const int height, const bool hasAlpha)
+{
+	int blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+	int blockSize = hasAlpha ? 16 : 8;
+	std::vector<uint8_t> blocks(blocksX * blocksY * blockSize);
+
+	uint8_t pixels[16 * 4];
+	for (int by = 0; by < blocksY; ++by) {
+		for (int bx = 0; bx < blocksX; ++bx) {
+			// Gather the block (the pixels outside of the image repeat the last row / column)
+			for (int y = 0; y < 4; ++y) {
+				for (int x = 0; x < 4; ++x) {
+					int px = std::min(bx * 4 + x, width - 1);
+					int py = std::min(by * 4 + y, height - 1);
+					memcpy(pixels + (y * 4 + x) * 4, &image[(py * width + px) * 4], 4);
+				}
+			}
+
+			uint8_t* block = &blocks[(by * blocksX + bx) * blockSize];
+			if (hasAlpha) {
+				CompressBC3(pixels, block);
+			}
+			else {
+				CompressBC1(pixels, block);
+			}
+		}
+	}
+
+	return blocks;
+}
+
+std::vector<uint8_t> GameEngine::CompressedTexture::Downsample(const std::vector<uint8_t>& image, const int width, const int height)
+{
+	int newWidth = std::max(1, width / 2), newHeight = std::max(1, height / 2);
+	std::vector<uint8_t> result(newWidth * newHeight * 4);
+
+	for (int y = 0; y < newHeight; ++y) {
+		for (int x = 0; x < newWidth; ++x) {
+			int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+			int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+
+			for (int c = 0; c < 4; ++c) {
+				int sum = image[(y0 * width + x0) * 4 + c] + image[(y0 * width + x1) * 4 + c] +
+					image[(y1 * width + x0) * 4 + c] + image[(y1 * width + x1) * 4 + c];
+				result[(y * newWidth + x) * 4 + c] = (uint8_t)((sum + 2) / 4);
+			}
+		}
+	}
+
+	return result;
+}
+
+bool GameEngine::CompressedTexture::Bake(const std::string& imagePath, const std::string& ktxPath)
+{
+	int width, height, channels;
+	unsigned char* data = stbi_load(imagePath.c_str(), &width, &height, &channels, 4);
+	if (data == nullptr) return false;
+
+	std::vector<uint8_t> image(data, data + width * height * 4);
+	stbi_image_free(data);
+
+	// Only the images with transparent pixels use BC3, the others use BC1 (half the size)
+	bool hasAlpha = false;
+	if (channels == 2 || channels == 4) {
+		for (size_t i = 3; i < image.size() && !hasAlpha; i += 4) {
+			hasAlpha = image[i] != 255;
+		}
+	}
+
+	// Compress every mip level, down to 1x1
+	std::vector<std::vector<uint8_t>> levels;
+	int levelWidth = width, levelHeight = height;
+	while (true) {
+		levels.push_back(CompressImage(image, levelWidth, levelHeight, hasAlpha));
+		if (levelWidth == 1 && levelHeight == 1) break;
+
+		image = Downsample(image, levelWidth, levelHeight);
+		levelWidth = std::max(1, levelWidth / 2);
+		levelHeight = std::max(1, levelHeight / 2);
+	}
+
+	KtxHeader header = {};
+	memcpy(header.identifier, ktxIdentifier, sizeof(ktxIdentifier));
+	header.endianness = ktxEndianness;
+	header.glTypeSize = 1;
+	header.glInternalFormat = hasAlpha ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	header.glBaseInternalFormat = hasAlpha ? GL_RGBA : GL_RGB;
+	header.pixelWidth = width;
+	header.pixelHeight = height;
+	header.numberOfFaces = 1;
+	header.numberOfMipmapLevels = (uint32_t)levels.size();
+
+	std::ofstream file(ktxPath, std::ios::binary);
+	if (!file) return false;
+
+	file.write((const char*)&header, sizeof(header));
+	for (auto& level : levels) {
+		// The size of the blocks is always a multiple of 4, so no padding is needed
+		uint32_t imageSize = (uint32_t)level.size();
+		file.write((const char*)&imageSize, sizeof(imageSize));
+		file.write((const char*)level.data(), level.size());
+	}
+
+	return file.good();
+}
+
+Texture2D* GameEngine::CompressedTexture::Load(const std::string& ktxPath, const GLenum wrappingMode)
+{
+	std::ifstream file(ktxPath, std::ios::binary);
+	if (!file) return nullptr;
+
+	KtxHeader header;
+	file.read((char*)&header, sizeof(header));
+	if (!file || memcmp(header.identifier, ktxIdentifier, sizeof(ktxIdentifier)) != 0 || header.endianness != ktxEndianness) {
+		return nullptr;
+	}
+
+	// Only the formats created by Bake are supported
+	if (header.glInternalFormat != GL_COMPRESSED_RGB_S3TC_DXT1_EXT && header.glInternalFormat != GL_COMPRESSED_RGBA_S3TC_DXT5_EXT) {
+		return nullptr;
+	}
+	file.seekg(header.bytesOfKeyValueData, std::ios::cur);
+
+	GLuint textureID;
+	glGenTextures(1, &textureID);
+	glBindTexture(GL_TEXTURE_2D, textureID);
+
+	// Upload the levels as they are stored in the file
+	std::vector<char> level;
+	GLsizei width = header.pixelWidth, height = header.pixelHeight;
+	for (uint32_t i = 0; i < header.numberOfMipmapLevels; ++i) {
+		uint32_t imageSize;
+		file.read((char*)&imageSize, sizeof(imageSize));
+		level.resize(imageSize);
+		file.read(level.data(), imageSize);
+		if (!file) {
+			glDeleteTextures(1, &textureID);
+			return nullptr;
+		}
+
+		glCompressedTexImage2D(GL_TEXTURE_2D, i, header.glInternalFormat, width, height, 0, imageSize, level.data());
+		width = std::max(1, width / 2);
+		height = std::max(1, height / 2);
+	}
+
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, header.numberOfMipmapLevels - 1);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, header.numberOfMipmapLevels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrappingMode);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrappingMode);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY_EXT, 4);
+	glBindTexture(GL_TEXTURE_2D, 0);
+
+	Texture2D* texture = new Texture2D();
+	texture->Init(textureID, header.pixelWidth, header.pixelHeight, header.glBaseInternalFormat == GL_RGBA ? 4 : 3);
+	return texture;
+}
+
+bool GameEngine::CompressedTexture::IsSupported()
+{
+	return GLEW_EXT_texture_compression_s3tc != 0;
+}
\ No newline at end of file
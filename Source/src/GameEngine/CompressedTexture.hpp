@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include <Core/Engine.h>
+
+namespace GameEngine {
+	/// <summary>
+	/// Textures stored in a KTX (version 1) file, compressed with BC1 (opaque) or BC3 (with transparency),
+	/// with all their mip levels. They are created offline from the PNG files (Bake), and at
+	/// runtime the blocks are uploaded directly (Load), without decoding the image or
+	/// generating the mipmaps. They also take 4-8 times less video memory.
+	/// </summary>
+	class CompressedTexture {
+	public:
+		/// <summary>
+		/// Create a compressed texture file from an image file
+		/// </summary>
+		/// <param name="imagePath">The image (any format supported by stb_image)</param>
+		/// <param name="ktxPath">The KTX file that is created</param>
+		/// <returns>If the file was created</returns>
+		static bool Bake(const std::string& imagePath, const std::string& ktxPath);
+
+		/// <summary>
+		/// Load a compressed texture file. Must be called from the thread with the OpenGL context.
+		/// </summary>
+		/// <param name="ktxPath">The KTX file</param>
+		/// <param name="wrappingMode">The wrapping mode of the texture</param>
+		/// <returns>The texture, or null if the file couldn't be loaded</returns>
+		static Texture2D* Load(const std::string& ktxPath, const GLenum wrappingMode);
+
+		/// <summary>
+		/// Check if the GPU supports the compressed formats
+		/// </summary>
+		static bool IsSupported();
+
+	private:
+		/// <summary>
+		/// Compress a 4x4 block of RGBA pixels (row by row) with BC1, in 8 bytes
+		/// </summary>
+		static void CompressBC1(const uint8_t* pixels, uint8_t* block);
+
+		/// <summary>
+		/// Compress a 4x4 block of RGBA pixels (row by row) with BC3, in 16 bytes
+		/// </summary>
+		static void CompressBC3(const uint8_t* pixels, uint8_t* block);
+
+		/// <summary>
+		/// Compress an RGBA image, block by block
+		/// </summary>
+		static std::vector<uint8_t> CompressImage(const std::vector<uint8_t>& image, const int width, const int height, const bool hasAlpha);
+
+		/// <summary>
+		/// Create the next (half size) mip level of an RGBA image, using a box filter
+		/// </summary>
+		static std::vector<uint8_t> Downsample(const std::vector<uint8_t>& image, const int width, const int height);
+	};
+}
\ No newline at end of file
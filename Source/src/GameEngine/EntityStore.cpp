@@ -0,0 +1,143 @@
+#include "EntityStore.hpp"
+
+GameEngine::EntityHandle GameEngine::EntityStore::Create(const GameObject& object)
+{
+	// Reuse a free slot if possible
+	unsigned int slotIndex;
+	if (!freeSlots.empty()) {
+		slotIndex = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		slotIndex = (unsigned int)slots.size();
+		slots.push_back(Slot());
+	}
+
+	Slot& slot = slots[slotIndex];
+	slot.alive = true;
+	slot.denseIndex = (unsigned int)handles.size();
+
+	EntityHandle handle;
+	handle.index = slotIndex;
+	handle.generation = slot.generation;
+
+	// Copy the components of the object at the end of the arrays
+	unsigned char entityFlags = 0;
+	const Collider* collider = object.getCollider();
+	if (collider != nullptr) {
+		entityFlags |= EntityFlags::HasCollider;
+		colliders.push_back(*collider);
+	}
+	else {
+		colliders.push_back(Collider(object.getID(), object.getPosition(), glm::vec3(0)));
+	}
+
+	Light light = {};
+	if (object.getLight(&light)) {
+		entityFlags |= EntityFlags::IsLight;
+	}
+
+	handles.push_back(handle);
+	types.push_back(object.getType());
+	flags.push_back(entityFlags);
+	transforms.push_back(object.getTransform());
+	transforms.back().previousPosition = transforms.back().position;
+	bodies.push_back(object.getRigidBody());
+	renders.push_back(object.getRenderComponent());
+	lights.push_back(light);
+
+	return handle;
+}
+
+void GameEngine::EntityStore::Place(const size_t index, const glm::vec3& position)
+{
+	transforms[index].position = position;
+	transforms[index].previousPosition = position;
+	bodies[index].state.x = position;
+	colliders[index].setPosition(position);
+	lights[index].position = position;
+}
+
+void GameEngine::EntityStore::Destroy(const EntityHandle handle)
+{
+	if (!IsAlive(handle)) return;
+
+	Slot& slot = slots[handle.index];
+	size_t index = slot.denseIndex;
+	size_t last = handles.size() - 1;
+
+	// Move the last entity in the place of the removed one
+	if (index != last) {
+		handles[index] = handles[last];
+		types[index] = types[last];
+		flags[index] = flags[last];
+		transforms[index] = transforms[last];
+		bodies[index] = bodies[last];
+		colliders[index] = colliders[last];
+		renders[index] = renders[last];
+		lights[index] = lights[last];
+
+		slots[handles[index].index].denseIndex = (unsigned int)index;
+	}
+
+	handles.pop_back();
+	types.pop_back();
+	flags.pop_back();
+	transforms.pop_back();
+	bodies.pop_back();
+	colliders.pop_back();
+	renders.pop_back();
+	lights.pop_back();
+
+	// Invalidate the existing handles and mark the slot as reusable
+	slot.alive = false;
+	slot.generation++;
+	freeSlots.push_back(handle.index);
+}
+
+bool GameEngine::EntityStore::IsAlive(const EntityHandle handle) const
+{
+	return handle.index < slots.size() && slots[handle.index].alive && slots[handle.index].generation == handle.generation;
+}
+
+size_t GameEngine::EntityStore::IndexOf(const EntityHandle handle) const
+{
+	return slots[handle.index].denseIndex;
+}
+
+GameEngine::EntityHandle GameEngine::EntityStore::GetHandle(const unsigned int slotIndex) const
+{
+	EntityHandle handle;
+	handle.index = slotIndex;
+	handle.generation = slots[slotIndex].generation;
+	return handle;
+}
+
+size_t GameEngine::EntityStore::Count() const
+{
+	return handles.size();
+}
+
+bool GameEngine::EntityStore::HasFlag(const size_t index, const unsigned char flag) const
+{
+	return (flags[index] & flag) == flag;
+}
+
+void GameEngine::EntityStore::Reserve(const size_t capacity)
+{
+	slots.reserve(capacity);
+	freeSlots.reserve(capacity);
+	handles.reserve(capacity);
+	types.reserve(capacity);
+	flags.reserve(capacity);
+	transforms.reserve(capacity);
+	bodies.reserve(capacity);
+	colliders.reserve(capacity);
+	renders.reserve(capacity);
+	lights.reserve(capacity);
+}
+
+size_t GameEngine::EntityStore::Capacity() const
+{
+	return handles.capacity();
+}
\ No newline at end of file
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include "GameObject.hpp"
+
+namespace GameEngine {
+	/// <summary>
+	/// A reference to an entity stored in an EntityStore. The generation is incremented every
+	/// time a slot is reused, so handles to removed entities can be detected.
+	/// </summary>
+	struct EntityHandle {
+		unsigned int index = 0xFFFFFFFF;
+		unsigned int generation = 0;
+
+		bool operator==(const EntityHandle& other) const {
+			return index == other.index && generation == other.generation;
+		}
+
+		bool operator!=(const EntityHandle& other) const {
+			return !(*this == other);
+		}
+	};
+
+	/// <summary>
+	/// Flags that describe which optional components an entity has
+	/// </summary>
+	namespace EntityFlags {
+		const unsigned char HasCollider = 1 << 0;
+		const unsigned char IsLight = 1 << 1;
+	}
+
+	/// <summary>
+	/// Stores the entities of the game as densely packed component arrays (structure of arrays).
+	/// Element "i" of every component array belongs to the same entity, so the physics, collision
+	/// and rendering passes only go over the data they need. Removing an entity moves the last
+	/// entity in its place, keeping the arrays contiguous.
+	/// </summary>
+	class EntityStore {
+	private:
+		struct Slot {
+			unsigned int generation = 0;
+			unsigned int denseIndex = 0;
+			bool alive = false;
+		};
+
+		std::vector<Slot> slots;
+		std::vector<unsigned int> freeSlots;
+
+	public:
+		// -- Component arrays --
+		std::vector<EntityHandle> handles;
+		std::vector<ObjectType> types;
+		std::vector<unsigned char> flags;
+		std::vector<TransformComponent> transforms;
+		std::vector<RigidBody> bodies;
+		std::vector<Collider> colliders;
+		std::vector<RenderComponent> renders;
+		std::vector<Light> lights;
+
+		/// <summary>
+		/// Add a new entity, built from the components of a game object
+		/// </summary>
+		/// <param name="object">The game object used as a template</param>
+		/// <returns>The handle of the new entity</returns>
+		EntityHandle Create(const GameObject& object);
+
+		/// <summary>
+		/// Move an entity (its transform, body, collider and light) to a new position
+		/// </summary>
+		/// <param name="index">The index in the component arrays</param>
+		/// <param name="position">The new position</param>
+		void Place(const size_t index, const glm::vec3& position);
+
+		/// <summary>
+		/// Remove an entity. Handles to removed entities are ignored.
+		/// </summary>
+		/// <param name="handle">The handle of the entity</param>
+		void Destroy(const EntityHandle handle);
+
+		/// <summary>
+		/// Check if a handle still references an existing entity
+		/// </summary>
+		/// <param name="handle">The handle</param>
+		/// <returns>If the entity exists</returns>
+		bool IsAlive(const EntityHandle handle) const;
+
+		/// <summary>
+		/// Get the position of an entity in the component arrays. The index is valid only
+		/// until the next entity is removed.
+		/// </summary>
+		/// <param name="handle">The handle of an existing entity</param>
+		/// <returns>The index in the component arrays</returns>
+		size_t IndexOf(const EntityHandle handle) const;
+
+		/// <summary>
+		/// Get the handle of the entity stored in a slot (the "index" part of a handle)
+		/// </summary>
+		/// <param name="slotIndex">The index of the slot</param>
+		/// <returns>The handle of the entity in that slot</returns>
+		EntityHandle GetHandle(const unsigned int slotIndex) const;
+
+		/// <summary>
+		/// Get the number of entities
+		/// </summary>
+		/// <returns>The number of entities</returns>
+		size_t Count() const;
+
+		/// <summary>
+		/// Check if the entity at the specified index has some flag(s) set
+		/// </summary>
+		/// <param name="index">The index in the component arrays</param>
+		/// <param name="flag">The flag(s) to check</param>
+		/// <returns>If the flags are set</returns>
+		bool HasFlag(const size_t index, const unsigned char flag) const;
+
+		/// <summary>
+		/// Reserve space for a number of entities
+		/// </summary>
+		/// <param name="capacity">The number of entities</param>
+		void Reserve(const size_t capacity);
+
+		/// <summary>
+		/// Get the number of entities the component arrays can hold without allocating memory
+		/// </summary>
+		/// <returns>The capacity of the arrays</returns>
+		size_t Capacity() const;
+	};
+}
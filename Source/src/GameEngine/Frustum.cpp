@@ -0,0 +1,35 @@
+#include "Frustum.hpp"
+
+void GameEngine::Frustum::Extract(const glm::mat4& viewProjection)
+{
+	// The rows of the matrix (glm matrices are column-major)
+	glm::vec4 rows[4];
+	for (int i = 0; i < 4; ++i) {
+		rows[i] = glm::vec4(viewProjection[0][i], viewProjection[1][i], viewProjection[2][i], viewProjection[3][i]);
+	}
+
+	planes[0] = rows[3] + rows[0];
+	planes[1] = rows[3] - rows[0];
+	planes[2] = rows[3] + rows[1];
+	planes[3] = rows[3] - rows[1];
+	planes[4] = rows[3] + rows[2];
+	planes[5] = rows[3] - rows[2];
+
+	for (auto& plane : planes) {
+		plane /= glm::length(glm::vec3(plane));
+	}
+}
+
+bool GameEngine::Frustum::IsBoxVisible(const glm::vec3& min, const glm::vec3& max) const
+{
+	for (auto& plane : planes) {
+		// The corner of the box that is the furthest along the normal of the plane
+		glm::vec3 corner = glm::vec3(
+			plane.x >= 0 ? max.x : min.x,
+			plane.y >= 0 ? max.y : min.y,
+			plane.z >= 0 ? max.z : min.z);
+
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0) return false;
+	}
+	return true;
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <include/glm.h>
+
+namespace GameEngine {
+	/// <summary>
+	/// The view frustum of a camera, stored as 6 planes (with the normals pointing inside).
+	/// Used to skip rendering the objects that can't be seen.
+	/// </summary>
+	class Frustum {
+	public:
+		/// <summary>
+		/// Extract the planes from a view-projection matrix (Gribb-Hartmann method)
+		/// </summary>
+		/// <param name="viewProjection">The matrix (projection * view)</param>
+		void Extract(const glm::mat4& viewProjection);
+
+		/// <summary>
+		/// Check if an axis-aligned box is (at least partially) inside the frustum.
+		/// The test is conservative - some boxes near the corners are reported as visible.
+		/// </summary>
+		/// <param name="min">The minimum corner of the box</param>
+		/// <param name="max">The maximum corner of the box</param>
+		/// <returns>If the box may be visible</returns>
+		bool IsBoxVisible(const glm::vec3& min, const glm::vec3& max) const;
+
+	private:
+		// Left, Right, Bottom, Top, Near, Far - (normal, distance)
+		glm::vec4 planes[6];
+	};
+}
\ No newline at end of file
@@ -1,29 +1,32 @@
 #include "GameObject.hpp"
+#include "ShaderUniforms.hpp"
 
 #include <iostream>
+#include <algorithm>
 
 long int GameEngine::GameObject::currentMaxID = 0;
 std::unordered_map<std::string, Mesh*>* GameEngine::GameObject::meshes = nullptr;
 std::unordered_map<std::string, Shader*>* GameEngine::GameObject::shaders = nullptr;
 std::unordered_map<std::string, Texture2D*>* GameEngine::GameObject::textures = nullptr;
 
-GameEngine::GameObject::GameObject() : id(-1), type(""), isInJump(false), distortedTime(0), _hasTexture(false) , _isLight(false), _isRendered(true), position(glm::vec3(0)), mesh(nullptr), shader(nullptr), collider(nullptr), texture(nullptr) {};
+GameEngine::GameObject::GameObject() : id(-1), _isLight(false), collider(-1, glm::vec3(0), glm::vec3(0)), hasCollider(false) {};
 
-GameEngine::GameObject::GameObject(const std::string& type, const glm::vec3& position) : type(type), position(position), distortedTime(0), mesh(nullptr), shader(nullptr), collider(nullptr), texture(nullptr) {
+GameEngine::GameObject::GameObject(const ObjectType type, const glm::vec3& position) : type(type), collider(-1, glm::vec3(0), glm::vec3(0)), hasCollider(false) {
 	id = currentMaxID++;
-	_isRendered = true;
 	_isLight = false;
-	_hasTexture = false;
-	isInJump = false;
-
-	if (type == "player") {
-		scale = glm::vec3(ObjectConstants::playerHeight * 0.25f);
-		scale *= glm::vec3(1, 1, -1);
-		mesh = (*meshes)["spaceship"];
-		shader = (*shaders)["Spaceship"];
-		texture = (*textures)["spaceship"];
-		_hasTexture = true;
-		material = {
+	transform.position = position;
+
+	switch (type.category) {
+	case ObjectCategory::Player: {
+		transform.scale = glm::vec3(ObjectConstants::playerHeight * 0.25f);
+		transform.scale *= glm::vec3(1, 1, -1);
+		render.mesh = (*meshes)["spaceship"];
+		render.shader = (*shaders)["Spaceship"];
+		render.texture = (*textures)["spaceship"];
+		render.emissionMaps[0] = (*textures)["spaceship_window"];
+		render.emissionMaps[1] = (*textures)["spaceship_exhaust"];
+		render.hasTexture = true;
+		render.material = {
 			glm::vec3(0.f),
 			glm::vec3(0.2f),
 			glm::vec3(2.f),
@@ -31,18 +34,19 @@ GameEngine::GameObject::GameObject(const std::string& type, const glm::vec3& pos
 			128.f
 		};
 
-		collider = new Collider(id, position, glm::vec3(ObjectConstants::playerHeight / 2));
+		collider = Collider(id, position, glm::vec3(ObjectConstants::playerHeight / 2));
+		hasCollider = true;
 
 		rigidbody.state.x = position;
 		rigidbody.state.gravity_coef = .33f;
-	}
-	else if (type.rfind("platform_", 0) == 0) {
-		scale = glm::vec3(1, 0.25f, ObjectConstants::platformLength);
-		mesh = (*meshes)["cube"];
-		shader = (*shaders)["EmmisiveTransparency"];
-		texture = (*textures)["platform"];
-		_hasTexture = true;
-		material = {
+	} break;
+	case ObjectCategory::Platform: {
+		transform.scale = glm::vec3(1, 0.25f, ObjectConstants::platformLength);
+		render.mesh = (*meshes)["cube"];
+		render.shader = (*shaders)["EmmisiveTransparency"];
+		render.texture = (*textures)["platform"];
+		render.hasTexture = true;
+		render.material = {
 			glm::vec3(1, 0, 0),
 			glm::vec3(1, 0, 0),
 			glm::vec3(32.f),
@@ -51,22 +55,23 @@ GameEngine::GameObject::GameObject(const std::string& type, const glm::vec3& pos
 		};
 
 		// Compute the Y component of the position
-		this->position.y = ObjectConstants::platformTopHeight - scale.y / 2;
+		transform.position.y = ObjectConstants::platformTopHeight - transform.scale.y / 2;
 
-		collider = new Collider(id, this->position, scale);
-		collider->affectsPhysics(true);
+		collider = Collider(id, transform.position, transform.scale);
+		hasCollider = true;
+		collider.affectsPhysics(true);
 
-		rigidbody.state.x = this->position;
+		rigidbody.state.x = transform.position;
 		rigidbody.physics_enabled = false;
 
-		UpdatePlatformData();
-	}
-	else if (type == "planet") {
-		_hasTexture = true;
+		UpdatePlatformData(type, render.material);
+	} break;
+	case ObjectCategory::Planet: {
+		render.hasTexture = true;
 		_isLight = false;
-		mesh = (*meshes)["c_sphere"];
-		shader = (*shaders)["Planet"];
-		material = {
+		render.mesh = (*meshes)["c_sphere"];
+		render.shader = (*shaders)["Planet"];
+		render.material = {
 			glm::vec3(1, 0, 0),
 			glm::vec3(1, 0, 0),
 			glm::vec3(32.f),
@@ -74,54 +79,55 @@ GameEngine::GameObject::GameObject(const std::string& type, const glm::vec3& pos
 			16.f
 		};
 
-		collider = new Collider(id, this->position, 0.001f);
-		collider->affectsPhysics(false);
-		rigidbody.state.x = this->position;
+		collider = Collider(id, transform.position, 0.001f);
+		hasCollider = true;
+		collider.affectsPhysics(false);
+		rigidbody.state.x = transform.position;
 		rigidbody.physics_enabled = true;
 		rigidbody.state.drag_coef = 0.f;
 		rigidbody.state.gravity_coef = 0.f;
 
-		int planet = rand() % 6;
+		int planet = type.variant % ObjectConstants::planetKinds;
 		switch (planet) {
 		case 0: {
-			scale = glm::vec3(0.5);
-			texture = (*textures)["icy"];
-			material.shininess = 2.5;
+			transform.scale = glm::vec3(0.5);
+			render.texture = (*textures)["icy"];
+			render.material.shininess = 2.5;
 		} break;
 		case 1: {
-			scale = glm::vec3(0.5);
-			texture = (*textures)["mars"];
-			material.shininess = 1.5;
+			transform.scale = glm::vec3(0.5);
+			render.texture = (*textures)["mars"];
+			render.material.shininess = 1.5;
 		} break;
 		case 2: {
-			scale = glm::vec3(1);
-			texture = (*textures)["neptune"];
-			material.shininess = 2.5;
+			transform.scale = glm::vec3(1);
+			render.texture = (*textures)["neptune"];
+			render.material.shininess = 2.5;
 		} break;
 		case 3: {
-			scale = glm::vec3(2);
-			texture = (*textures)["jupiter"];
-			material.shininess = 2.5;
+			transform.scale = glm::vec3(2);
+			render.texture = (*textures)["jupiter"];
+			render.material.shininess = 2.5;
 		} break;
 		case 4: {
-			scale = glm::vec3(2);
-			texture = (*textures)["uranus"];
-			material.shininess = 1.5;
+			transform.scale = glm::vec3(2);
+			render.texture = (*textures)["uranus"];
+			render.material.shininess = 1.5;
 		} break;
 		case 5: {
-			scale = glm::vec3(1);
-			texture = (*textures)["venus"];
-			material.shininess = 2.5;
+			transform.scale = glm::vec3(1);
+			render.texture = (*textures)["venus"];
+			render.material.shininess = 2.5;
 		} break;
 		}
-	}
-	else if (type == "star") {
-		scale = glm::vec3(4.);
-		_hasTexture = true;
+	} break;
+	case ObjectCategory::Star: {
+		transform.scale = glm::vec3(4.);
+		render.hasTexture = true;
 		_isLight = true;
-		mesh = (*meshes)["c_sphere"];
-		shader = (*shaders)["Planet"];
-		material = {
+		render.mesh = (*meshes)["c_sphere"];
+		render.shader = (*shaders)["Planet"];
+		render.material = {
 			glm::vec3(1, 0, 0),
 			glm::vec3(1, 0, 0),
 			glm::vec3(32.f),
@@ -129,9 +135,10 @@ GameEngine::GameObject::GameObject(const std::string& type, const glm::vec3& pos
 			96.f
 		};
 
-		collider = new Collider(id, this->position, 0.001f);
-		collider->affectsPhysics(false);
-		rigidbody.state.x = this->position;
+		collider = Collider(id, transform.position, 0.001f);
+		hasCollider = true;
+		collider.affectsPhysics(false);
+		rigidbody.state.x = transform.position;
 		rigidbody.physics_enabled = true;
 		rigidbody.state.drag_coef = 0.f;
 		rigidbody.state.gravity_coef = 0.f;
@@ -147,24 +154,24 @@ GameEngine::GameObject::GameObject(const std::string& type, const glm::vec3& pos
 			glm::cos(glm::radians(90.f)), glm::cos(glm::radians(90.f))
 		};
 
-		int star = rand() % 2;
+		int star = type.variant % ObjectConstants::starKinds;
 		switch (star) {
 		case 0: {
-			texture = (*textures)["star_blue"];
+			render.texture = (*textures)["star_blue"];
 			light.diffuse = glm::vec3(0.75f, 0.75f, 5.f);
 		} break;
 		case 1: {
-			texture = (*textures)["star_red"];
+			render.texture = (*textures)["star_red"];
 			light.diffuse =glm::vec3(5.f, 0.75f, 0.75f);
 		} break;
 		}
-	}
-	else if (type.rfind("obstacle_", 0) == 0) {
-		scale = glm::vec3(1.);
-		mesh = (*meshes)["cube"];
-		shader = (*shaders)["EmmisiveTransparency"];
-		_hasTexture = true;
-		material = {
+	} break;
+	case ObjectCategory::Obstacle: {
+		transform.scale = glm::vec3(1.);
+		render.mesh = (*meshes)["cube"];
+		render.shader = (*shaders)["EmmisiveTransparency"];
+		render.hasTexture = true;
+		render.material = {
 			glm::vec3(1, 0, 0),
 			glm::vec3(1, 0, 0),
 			glm::vec3(1.f),
@@ -173,49 +180,51 @@ GameEngine::GameObject::GameObject(const std::string& type, const glm::vec3& pos
 		};
 
 
-		rigidbody.state.x = this->position;
+		rigidbody.state.x = transform.position;
 		rigidbody.physics_enabled = false;
 
-		std::string type_string = type.substr(type.find("_") + 1);
-		if (type_string == "bad") {
-			material.ambient = glm::vec3(1, 0, 0);
-			material.emmisive = glm::vec3(122, 0, 0);
-			texture = (*textures)["obstacle1"];
-			scale = glm::vec3(10, 2, 1);
-			collider = new Collider(id, position, scale);
-			collider->affectsPhysics(true);
+		if (type.obstacleKind() == ObstacleKind::Bad) {
+			render.material.ambient = glm::vec3(1, 0, 0);
+			render.material.emmisive = glm::vec3(122, 0, 0);
+			render.texture = (*textures)["obstacle1"];
+			transform.scale = glm::vec3(10, 2, 1);
+			collider = Collider(id, position, transform.scale);
+			hasCollider = true;
+			collider.affectsPhysics(true);
 		}
-		else if (type_string == "good") {
-			material.ambient = glm::vec3(0.9, 0.6, 0.2);
-			material.emmisive = glm::vec3(0, 122, 0);
-			texture = (*textures)["obstacle2"];
-			collider = new Collider(id, this->position, glm::vec3(1.2));
-			collider->affectsPhysics(true);
+		else if (type.obstacleKind() == ObstacleKind::Good) {
+			render.material.ambient = glm::vec3(0.9, 0.6, 0.2);
+			render.material.emmisive = glm::vec3(0, 122, 0);
+			render.texture = (*textures)["obstacle2"];
+			collider = Collider(id, transform.position, glm::vec3(1.2));
+			hasCollider = true;
+			collider.affectsPhysics(true);
 		}
-	}
-	else if (type == "sphere") {
-		scale = glm::vec3(0.1);
-		mesh = (*meshes)["c_sphere"];
-		shader = (*shaders)["Base"];
-		material = {
+	} break;
+	case ObjectCategory::Sphere: {
+		transform.scale = glm::vec3(0.1);
+		render.mesh = (*meshes)["c_sphere"];
+		render.shader = (*shaders)["Base"];
+		render.material = {
 			glm::vec3(0.f),
 			glm::vec3(1, 0, 0),
 			glm::vec3(5.f),
 			glm::vec3(0.3f),
 			.25f
 		};
-		collider = new Collider(id, position, 0.1);
+		collider = Collider(id, position, 0.1);
+		hasCollider = true;
 
-		rigidbody.state.x = this->position;
+		rigidbody.state.x = transform.position;
 		rigidbody.physics_enabled = false;
-	}
-	else if (type == "skybox") {
-		scale = glm::vec3(200.f);
-		mesh = (*meshes)["sphere"];
-		shader = (*shaders)["Skybox"];
-		texture = (*textures)["skybox"];
-		_hasTexture = true;
-		material = {
+	} break;
+	case ObjectCategory::Skybox: {
+		transform.scale = glm::vec3(200.f);
+		render.mesh = (*meshes)["sphere"];
+		render.shader = (*shaders)["Skybox"];
+		render.texture = (*textures)["skybox"];
+		render.hasTexture = true;
+		render.material = {
 			glm::vec3(1.f),
 			glm::vec3(1.f),
 			glm::vec3(0.f),
@@ -223,117 +232,51 @@ GameEngine::GameObject::GameObject(const std::string& type, const glm::vec3& pos
 			.0f
 		};
 
-		rigidbody.state.x = this->position;
+		rigidbody.state.x = transform.position;
 		rigidbody.physics_enabled = false;
-	}
-	else if (type == "fuelbar") {
-		scale = glm::vec3(1, 1, 1);
-
-		mesh = (*meshes)["box"];
-		shader = (*shaders)["UI"];
-		material = {
-			glm::vec3(0.9, 0.6, 0.2),
-			glm::vec3(0.9, 0.6, 0.2),
-			glm::vec3(5.f),
-			glm::vec3(0.3f),
-			.25f
-		};
-	}
-	else if (type == "ufuelbar") {
-		scale = glm::vec3(1, 1, 0.5);
-
-		mesh = (*meshes)["box"];
-		shader = (*shaders)["UI"];
-
-		material = {
-			glm::vec3(0.5f),
-			glm::vec3(0.5f),
-			glm::vec3(5.f),
-			glm::vec3(0.3f),
-			.25f
-		};
-	}
-	else if (type == "life") {
-		scale = glm::vec3(0.125);
-
-		mesh = (*meshes)["box"];
-		shader = (*shaders)["UI"];
-
-		material = {
-			glm::vec3(0.7, 0.1, 0.2),
-			glm::vec3(0.7, 0.1, 0.2),
-			glm::vec3(5.f),
-			glm::vec3(0.3f),
-			.25f
-		};
-		_hasTexture = true;
-		texture = (*textures)["life"];
+	} break;
+	default:
+		break;
 	}
 }
 
-void GameEngine::GameObject::UpdatePlatformData()
+void GameEngine::GameObject::UpdatePlatformData(const ObjectType type, Material& material)
 {
 	// Make sure this is a platform
-	if (type.rfind("platform_", 0) != 0) return;
+	if (!type.is(ObjectCategory::Platform)) return;
 
-	std::string color_string = type.substr(type.find("_") + 1);
-	if (color_string == "red") {
-		material.ambient = glm::vec3(1, 0, 0);
-		material.emmisive = glm::vec3(25.5, 0, 0);
-	}
-	else if (color_string == "yellow") {
-		material.ambient = glm::vec3(1, 1, 0);
-		material.emmisive = glm::vec3(25.5, 25.5, 0);
-	}
-	else if (color_string == "orange") {
-		material.ambient = glm::vec3(0.9, 0.6, 0.2);
-		material.emmisive = glm::vec3(25.9, 9.9, 7.1);
-	}
-	else if (color_string == "green") {
-		material.ambient = glm::vec3(0.9, 0.6, 0.2);
-		material.emmisive = glm::vec3(0, 25.5, 0);
-	}
-	else if (color_string == "purple") {
-		material.ambient = glm::vec3(0.5, 0.1, 0.4);
-		material.emmisive = glm::vec3(12.7, 2.5, 10.2);
-	}
-	else if (color_string == "blue") {
-		material.ambient = glm::vec3(0, 0, 1);
-		material.emmisive = glm::vec3(4.5, 5.5, 22.5);
-	}
-	else if (color_string == "white") {
-		material.ambient = glm::vec3(1);
-		material.emmisive = glm::vec3(25.5);
-	}
+	const ObjectConstants::PlatformColorData& data = ObjectConstants::platformColors[type.variant];
+	material.ambient = data.ambient;
+	material.emmisive = data.emmisive;
 }
 
-GameEngine::GameObject::GameObject(const GameObject& other)
+GameEngine::GameObject::GameObject(const GameObject& other) : collider(other.collider)
 {
 	id = other.id;
 	_isLight = other._isLight;
-	_isRendered = other._isRendered;
-	_hasTexture = other._hasTexture;
-	position = other.position;
 	type = other.type;
-	scale = other.scale;
-	mesh = other.mesh;
-	shader = other.shader;
-	collider = other.collider;
+	transform = other.transform;
+	render = other.render;
+	hasCollider = other.hasCollider;
 	rigidbody = other.rigidbody;
-	texture = other.texture;
-	material = other.material;
 	light = other.light;
 }
 
-void GameEngine::GameObject::Render(GameEngine::Camera* camera, const std::vector<Light>& lights)
+void GameEngine::GameObject::Render(GameEngine::Camera* camera)
 {
-	glm::mat4 matrix = glm::mat4(1);
-	matrix = Translate(matrix, position);
-	matrix = Scale(matrix, scale);
+	Render(camera, transform, render);
+}
 
-	UpdatePlatformData();
+void GameEngine::GameObject::Render(GameEngine::Camera* camera, const TransformComponent& transform, const RenderComponent& render)
+{
+	Shader* shader = render.shader;
+	const Material& material = render.material;
+
+	if (render.mesh == nullptr || shader == nullptr || !render.isRendered) return;
 
-	if (mesh == nullptr || shader == nullptr || !_isRendered) return;
+	glm::mat4 matrix = glm::mat4(1);
+	matrix = Translate(matrix, transform.position);
+	matrix = Scale(matrix, transform.scale);
 
 	// Render the object
 	glUseProgram(shader->program);
@@ -343,173 +286,83 @@ void GameEngine::GameObject::Render(GameEngine::Camera* camera, const std::vecto
 	glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(camera->projectionMatrix));
 	glUniformMatrix4fv(shader->loc_model_matrix, 1, GL_FALSE, glm::value_ptr(matrix));
 
-	// Bind Lights Data
+	// Bind Camera Data (the lights are in the shared light buffer)
 	glm::vec3 cameraPos = camera->position;
 	glUniform3fv(shader->loc_eye_pos, 1, glm::value_ptr(cameraPos));
-	glUniform1i(glGetUniformLocation(shader->program, "lights_count"), (GLint)lights.size());
-
-	// Send the data for all the lights
-	int id = 0;
-	for (auto _light : lights) {
-		std::string name = "lights[";
-		glUniform1i(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].type").c_str()), (GLint)_light.type);
-		glUniform3fv(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].position").c_str()), 1, glm::value_ptr(_light.position));
-		glUniform3fv(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].direction").c_str()), 1, glm::value_ptr(_light.direction));
-		glUniform3fv(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].ambient").c_str()), 1, glm::value_ptr(_light.ambient));
-		glUniform3fv(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].diffuse").c_str()), 1, glm::value_ptr(_light.diffuse));
-		glUniform3fv(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].specular").c_str()), 1, glm::value_ptr(_light.specular));
-		glUniform1f(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].constant").c_str()), (GLfloat)_light.constant);
-		glUniform1f(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].linear").c_str()), (GLfloat)_light.linear);
-		glUniform1f(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].quadratic").c_str()), (GLfloat)_light.quadratic);
-		glUniform1f(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].cutOff").c_str()), (GLfloat)_light.cutOff);
-		glUniform1f(glGetUniformLocation(shader->program, (name + std::to_string(id) + "].outerCutOff").c_str()), (GLfloat)_light.outerCutOff);
-		id++;
-	}
+	const ShaderUniforms& uniforms = ShaderUniforms::Get(shader);
 
 	// Bind Material Data
-	glUniform3fv(glGetUniformLocation(shader->program, "material.emmisive"), 1, glm::value_ptr(material.emmisive));
-	glUniform3fv(glGetUniformLocation(shader->program, "material.ambient"), 1, glm::value_ptr(material.ambient));
-	glUniform3fv(glGetUniformLocation(shader->program, "material.diffuse"), 1, glm::value_ptr(material.diffuse));
-	glUniform3fv(glGetUniformLocation(shader->program, "material.specular"), 1, glm::value_ptr(material.specular));
-	glUniform1f(glGetUniformLocation(shader->program, "material.shininess"), material.shininess);
+	glUniform3fv(uniforms.material.emmisive, 1, glm::value_ptr(material.emmisive));
+	glUniform3fv(uniforms.material.ambient, 1, glm::value_ptr(material.ambient));
+	glUniform3fv(uniforms.material.diffuse, 1, glm::value_ptr(material.diffuse));
+	glUniform3fv(uniforms.material.specular, 1, glm::value_ptr(material.specular));
+	glUniform1f(uniforms.material.shininess, material.shininess);
 	
 	// Bind Texture Data
-	if (_hasTexture) {
+	if (render.hasTexture) {
 		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, texture->GetTextureID());
-		glUniform1i(glGetUniformLocation(shader->program, "texture1"), 0);
+		glBindTexture(GL_TEXTURE_2D, render.texture->GetTextureID());
+		glUniform1i(uniforms.texture1, 0);
 	}
-	glUniform1i(glGetUniformLocation(shader->program, "has_texture"), _hasTexture);
+	glUniform1i(uniforms.has_texture, render.hasTexture);
 
 	// Bind Other Data
-	glUniform1f(glGetUniformLocation(shader->program, "time"), (GLfloat)Engine::GetElapsedTime());
-	glUniform1i(glGetUniformLocation(shader->program, "is_distorted"), (distortedTime > 0));
+	glUniform1f(uniforms.time, (GLfloat)Engine::GetElapsedTime());
+	glUniform1i(uniforms.is_distorted, (render.distortedTime > 0));
 
-	if (type == "player")
+	if (render.emissionMaps[0] != nullptr && render.emissionMaps[1] != nullptr)
 	{
 		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, (*textures)["spaceship_window"]->GetTextureID());
-		glUniform1i(glGetUniformLocation(shader->program, "window_map"), 1);
+		glBindTexture(GL_TEXTURE_2D, render.emissionMaps[0]->GetTextureID());
+		glUniform1i(uniforms.window_map, 1);
 		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, (*textures)["spaceship_exhaust"]->GetTextureID());
-		glUniform1i(glGetUniformLocation(shader->program, "exhaust_map"), 2);
+		glBindTexture(GL_TEXTURE_2D, render.emissionMaps[1]->GetTextureID());
+		glUniform1i(uniforms.exhaust_map, 2);
 
 		// Spaceship shader data
 		using namespace ObjectConstants;
-		glUniform3fv(glGetUniformLocation(shader->program, "window_color_emm"), 1, glm::value_ptr(window_color_emm));
-		glUniform3fv(glGetUniformLocation(shader->program, "exhaust_color_emm"), 1, glm::value_ptr(exhaust_color_emm));
+		glUniform3fv(uniforms.window_color_emm, 1, glm::value_ptr(window_color_emm));
+		glUniform3fv(uniforms.exhaust_color_emm, 1, glm::value_ptr(exhaust_color_emm));
 	}
 
-	glBindVertexArray(mesh->GetBuffers()->VAO);
-	glDrawElements(mesh->GetDrawMode(), static_cast<int>(mesh->indices.size()), GL_UNSIGNED_SHORT, 0);
-}
-
-void GameEngine::GameObject::Render2D()
-{
-	glm::mat4 matrix = glm::mat4(1);
-	matrix = glm::translate(matrix, position);
-	matrix = glm::scale(matrix, scale);
-
-	if (mesh == nullptr || shader == nullptr || !_isRendered) return;
-
-	// Render the object
-	glUseProgram(shader->program);
-
-	// Bind MVP
-	glUniformMatrix4fv(shader->loc_view_matrix, 1, GL_FALSE, glm::value_ptr(glm::mat4(1)));
-	glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(glm::mat4(1)));
-	glUniformMatrix4fv(shader->loc_model_matrix, 1, GL_FALSE, glm::value_ptr(matrix));
-
-	glUniform3fv(glGetUniformLocation(shader->program, "object_color"), 1, glm::value_ptr(material.emmisive));
-
-	// Bind Texture Data
-	if (_hasTexture) {
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, texture->GetTextureID());
-	}
-	glUniform1i(glGetUniformLocation(shader->program, "has_texture"), _hasTexture);
-
-	glBindVertexArray(mesh->GetBuffers()->VAO);
-	glDrawElements(mesh->GetDrawMode(), static_cast<int>(mesh->indices.size()), GL_UNSIGNED_SHORT, 0);
-}
-
-std::vector<int> GameEngine::GameObject::ManageCollisions(std::vector<GameObject*> collCheck, std::unordered_map<long int, GameEngine::GameObject>* allObjects) {
-	// Only player collisions matter
-	if (type != "player") return std::vector<int>(0);
-
-	std::vector<GameObject*> platforms;
-	for (auto& obj : collCheck) {
-		if (obj->type.rfind("platform_", 0) == 0) {
-			platforms.push_back(obj);
-		}
-	}
-
-	// Get all the id's of the platforms this object collided with
-	std::vector<int> collided = CollisionCheck(platforms);
-
-	if (type == "player") {
-		// Update the physics of the player if he collided with a platform
-		// This will actually just mean that the player will "stick" to the platform
-		using namespace ObjectConstants;
-		if (collided.size() > 0 && rigidbody.state.x.y > -ObjectConstants::playerHeight / 4) {
-			rigidbody.state.v.y = 0;
-			rigidbody.state.x.y = ObjectConstants::platformTopHeight + ObjectConstants::playerHeight / 4;
-			isInJump = false;
-		}
-
-		std::vector<GameObject*> obstacles;
-		for (auto& obj : collCheck) {
-			if (obj->type.rfind("obstacle_", 0) == 0) {
-				obstacles.push_back(obj);
-			}
-		}
-
-		std::vector<int> collided_obst = CollisionCheck(obstacles);
-
-		for (auto& val : collided_obst) {
-			collided.push_back(val);
-		}
-
-		return collided;		// Continue other collisions from here
-	}
-	
-	return std::vector<int>(0);
+	glBindVertexArray(render.mesh->GetBuffers()->VAO);
+	glDrawElements(render.mesh->GetDrawMode(), static_cast<int>(render.mesh->indices.size()), GL_UNSIGNED_SHORT, 0);
 }
 
 void GameEngine::GameObject::isRendered(const bool isRendered)
 {
-	_isRendered = isRendered;
+	render.isRendered = isRendered;
 }
 
 glm::vec3 GameEngine::GameObject::getScale() const
 {
-	return scale;
+	return transform.scale;
 }
 
 void GameEngine::GameObject::setScale(const glm::vec3 newScale)
 {
-	if (collider != nullptr) {
-		collider->setDimensions(newScale);
+	if (hasCollider) {
+		collider.setDimensions(newScale);
 	}
-	scale = newScale;
+	transform.scale = newScale;
 }
 
 glm::vec3 GameEngine::GameObject::getPosition() const
 {
-	return position;
+	return transform.position;
 }
 
 void GameEngine::GameObject::setDistorted(const double time)
 {
-	distortedTime = time;
+	render.distortedTime = time;
 }
 
 void GameEngine::GameObject::setPosition(const glm::vec3 newPosition)
 { 
-	position = newPosition;
+	transform.position = newPosition;
 }
 
-std::string GameEngine::GameObject::getType() const
+GameEngine::ObjectType GameEngine::GameObject::getType() const
 {
 	return type;
 }
@@ -519,34 +372,23 @@ long int GameEngine::GameObject::getID() const
 	return id;
 }
 
-void GameEngine::GameObject::setType(const std::string newType)
+void GameEngine::GameObject::setType(const ObjectType newType)
 {
 	type = newType;
-}
-
-std::vector<int> GameEngine::GameObject::CollisionCheck(std::vector<GameObject*> gameObjects)
-{
-	std::vector<Collider*> colArray;
-
-	for (auto& obj : gameObjects) {
-		// Do not include this object in the search
-		if (obj->id != id) {
-			colArray.push_back(obj->collider);
-		}
-	}
-
-	return CollisionManager::getCollisions(*this->collider, colArray);
+	UpdatePlatformData(type, render.material);
 }
 
 void GameEngine::GameObject::UpdatePhysics(const double deltaTime)
 {
-	if (distortedTime > 0) distortedTime -= deltaTime;
+	if (render.distortedTime > 0) render.distortedTime -= deltaTime;
 
 	PhysixEngine::UpdatePhysics(rigidbody, deltaTime);
 
 	// Update the position from the physics engine
-	position = rigidbody.state.x;
-	collider->setPosition(position);
+	transform.position = rigidbody.state.x;
+	if (hasCollider) {
+		collider.setPosition(transform.position);
+	}
 }
 
 void GameEngine::GameObject::EnablePhysics()
@@ -583,7 +425,27 @@ GameEngine::RigidBody& GameEngine::GameObject::getRigidBody()
 	return rigidbody;
 }
 
+const GameEngine::RigidBody& GameEngine::GameObject::getRigidBody() const
+{
+	return rigidbody;
+}
+
+const GameEngine::TransformComponent& GameEngine::GameObject::getTransform() const
+{
+	return transform;
+}
+
+const GameEngine::RenderComponent& GameEngine::GameObject::getRenderComponent() const
+{
+	return render;
+}
+
+const GameEngine::Collider* GameEngine::GameObject::getCollider() const
+{
+	return hasCollider ? &collider : nullptr;
+}
+
 void GameEngine::GameObject::SetTexture(Texture2D& _texture) {
-	texture = new Texture2D(_texture);
-	_hasTexture = true;
+	render.texture = new Texture2D(_texture);
+	render.hasTexture = true;
 }
\ No newline at end of file
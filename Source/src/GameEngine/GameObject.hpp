@@ -6,6 +6,8 @@
 #include "Camera.hpp"
 #include "Transform.hpp"
 #include "Lighting.hpp"
+#include "Components.hpp"
+#include "ObjectTypes.hpp"
 
 namespace GameEngine {
 	namespace ObjectConstants {
@@ -24,10 +26,42 @@ namespace GameEngine {
 		/// </summary>
 		const float platformLength = 33.3f;
 
+		/// <summary>
+		/// The number of planet and star variants (textures)
+		/// </summary>
+		const unsigned char planetKinds = 6;
+		const unsigned char starKinds = 2;
 
 		// Some emmision colors for the spaceship
 		const glm::vec3 window_color_emm(3.55, 3.55, 1.51);
 		const glm::vec3 exhaust_color_emm(46, 103, 248);
+
+		struct PlatformColorData {
+			glm::vec3 ambient;
+			glm::vec3 emmisive;
+		};
+
+		/// <summary>
+		/// The colors of the platforms, indexed by PlatformColor
+		/// </summary>
+		const PlatformColorData platformColors[(int)PlatformColor::Count] = {
+			{ glm::vec3(1, 0, 0), glm::vec3(25.5, 0, 0) },				// Red
+			{ glm::vec3(0.9, 0.6, 0.2), glm::vec3(0, 25.5, 0) },		// Green
+			{ glm::vec3(1, 1, 0), glm::vec3(25.5, 25.5, 0) },			// Yellow
+			{ glm::vec3(0.9, 0.6, 0.2), glm::vec3(25.9, 9.9, 7.1) },	// Orange
+			{ glm::vec3(0.5, 0.1, 0.4), glm::vec3(12.7, 2.5, 10.2) },	// Purple
+			{ glm::vec3(0, 0, 1), glm::vec3(4.5, 5.5, 22.5) },			// Blue
+			{ glm::vec3(1), glm::vec3(25.5) }							// White
+		};
+
+		/// <summary>
+		/// The colors of the bars in the GPU profiler overlay (a bar uses the color at the index of its pass)
+		/// </summary>
+		const glm::vec3 profilerColors[] = {
+			glm::vec3(0.2, 0.6, 1), glm::vec3(0.9, 0.6, 0.2), glm::vec3(0.3, 0.9, 0.3),
+			glm::vec3(0.9, 0.3, 0.3), glm::vec3(0.8, 0.4, 0.9), glm::vec3(0.9, 0.9, 0.3)
+		};
+		const int profilerColorCount = sizeof(profilerColors) / sizeof(profilerColors[0]);
 	}
 
 	class GameObject
@@ -37,42 +71,15 @@ namespace GameEngine {
 
 		long int id;
 		bool _isLight;
-		bool _isRendered;
-		bool _hasTexture;
-		std::string type;
-
-		glm::vec3 position;
-		glm::vec3 scale;
+		ObjectType type;
 
-		Mesh *mesh;
-		Shader *shader;
+		TransformComponent transform;
+		RenderComponent render;
 		RigidBody rigidbody;
-		Collider *collider;
-		Texture2D *texture;
-		Material material;
+		Collider collider;		// Stored with the object (only valid if hasCollider is set)
+		bool hasCollider;
 		Light light;
-
-		/// <summary>
-		/// How much the object must be in a distorted state (specifically, the player)
-		/// </summary>
-		double distortedTime;
-
-		/// <summary>
-		/// In case this object is a platform, it is possible that it's type will change (color). So, the color data and others things must be updated
-		/// </summary>
-		void UpdatePlatformData();
-
-		/// <summary>
-		/// Find all existing collisions between this object and the specified objects
-		/// <param name="gameObjects">All the objects to be checked (this object is automatically ignored)</param>
-		/// <returns>An array with the id's of all the objects this object is colliding with</returns>
-		std::vector<int> CollisionCheck(std::vector<GameObject*> gameObjects);
 	public:
-		/// <summary>
-		/// Variable used by the player game object
-		/// </summary>
-		bool isInJump;
-
 		static std::unordered_map<std::string, Mesh*>* meshes;
 		static std::unordered_map<std::string, Shader*>* shaders;
 		static std::unordered_map<std::string, Texture2D*>* textures;
@@ -89,30 +96,36 @@ namespace GameEngine {
 		/// </summary>
 		/// <param name="type">The type of the object</param>
 		/// <param name="position">The position of the object</param>
-		GameObject(const std::string& type, const glm::vec3& position);
+		GameObject(const ObjectType type, const glm::vec3& position);
 
 		// Copy-Constructor
 		GameObject(const GameObject& other);
 
+		// Copy-Assignment (used to store the prototypes of the SpawnPool)
+		GameObject& operator=(const GameObject& other) = default;
+
 		/// <summary>
 		/// Renders the GameObject on the scene.
 		/// </summary>
 		/// <param name="camera">The camera used in the scene</param>
-		/// <param name="ligths">The lights in the scene</param>
-		void Render(GameEngine::Camera* camera, const std::vector<Light>& lights);
+		void Render(GameEngine::Camera* camera);
 
 		/// <summary>
-		/// Renders the GameObject on the scene.
+		/// Renders an object described by its components. Used both by the game objects
+		/// and by the objects stored in an EntityStore.
 		/// </summary>
-		void Render2D();
+		/// <param name="camera">The camera used in the scene</param>
+		/// <param name="transform">The position and scale of the object</param>
+		/// <param name="render">The rendering data of the object</param>
+		static void Render(GameEngine::Camera* camera, const TransformComponent& transform, const RenderComponent& render);
 
 		/// <summary>
-		/// Manage the collisions between this object and all the other game objects
+		/// In case an object is a platform, it is possible that it's type will change (color).
+		/// Update the material to match the platform type.
 		/// </summary>
-		/// <param name="coll_check">All the objects to be checked (this object is automatically ignored)</param>
-		/// <param name="allObjects">All the objects in the scene (pointer to the map)</param>
-		/// <returns>A vector with the id's of all the objects this object is colliding with</returns>
-		std::vector<int> ManageCollisions(std::vector<GameObject*> collCheck, std::unordered_map<long int, GameEngine::GameObject>* allObjects);
+		/// <param name="type">The type of the object</param>
+		/// <param name="material">The material that will be updated</param>
+		static void UpdatePlatformData(const ObjectType type, Material& material);
 
 		/// <summary>
 		/// Set if this object will be rendered
@@ -154,7 +167,7 @@ namespace GameEngine {
 		/// Get the type of the game object
 		/// </summary>
 		/// <returns>The type</returns>
-		std::string getType() const;
+		ObjectType getType() const;
 
 		/// <summary>
 		/// Get the id of the game object
@@ -166,7 +179,7 @@ namespace GameEngine {
 		/// Set the type of the object
 		/// </summary>
 		/// <param name="newType">The new type</param>
-		void setType(const std::string newType);
+		void setType(const ObjectType newType);
 
 		/// <summary>
 		/// Makes the physics computations to update things like position, velocity, acceleration, etc.
@@ -216,6 +229,30 @@ namespace GameEngine {
 		/// </summary>
 		/// <returns></returns>
 		RigidBody& getRigidBody();
+
+		/// <summary>
+		/// Returns the rigidbody of the object
+		/// </summary>
+		/// <returns></returns>
+		const RigidBody& getRigidBody() const;
+
+		/// <summary>
+		/// Get the transform (position and scale) of the object
+		/// </summary>
+		/// <returns>The transform</returns>
+		const TransformComponent& getTransform() const;
+
+		/// <summary>
+		/// Get the rendering data of the object
+		/// </summary>
+		/// <returns>The render component</returns>
+		const RenderComponent& getRenderComponent() const;
+
+		/// <summary>
+		/// Get the collider of the object
+		/// </summary>
+		/// <returns>The collider, or nullptr if the object has no collider</returns>
+		const Collider* getCollider() const;
 	};
 }
 
@@ -0,0 +1,96 @@
+#include "GpuProfiler.hpp"
+
+GameEngine::GpuProfiler::GpuProfiler() : frame(0) {}
+
+GameEngine::GpuProfiler::~GpuProfiler()
+{
+	for (auto& pass : passes) {
+		glDeleteQueries(bufferedFrames * 2, &pass.queries[0][0]);
+	}
+}
+
+void GameEngine::GpuProfiler::Collect(Pass& pass)
+{
+	unsigned int slot = frame % bufferedFrames;
+	if (!pass.issued[slot]) return;
+	pass.issued[slot] = false;
+
+	// If the GPU is still behind, drop the sample instead of waiting for it
+	GLint available = 0;
+	glGetQueryObjectiv(pass.queries[slot][1], GL_QUERY_RESULT_AVAILABLE, &available);
+	if (!available) return;
+
+	GLuint64 start, end;
+	glGetQueryObjectui64v(pass.queries[slot][0], GL_QUERY_RESULT, &start);
+	glGetQueryObjectui64v(pass.queries[slot][1], GL_QUERY_RESULT, &end);
+	double time = (end - start) / 1e6;
+
+	// Replace the oldest sample
+	if (pass.sampleCount == averagedFrames) {
+		pass.sum -= pass.samples[pass.nextSample];
+	}
+	else {
+		pass.sampleCount++;
+	}
+	pass.samples[pass.nextSample] = time;
+	pass.sum += time;
+	pass.nextSample = (pass.nextSample + 1) % averagedFrames;
+}
+
+void GameEngine::GpuProfiler::BeginFrame()
+{
+	frame++;
+	stack.clear();
+
+	// The slot of the current frame holds the queries issued "bufferedFrames" frames ago
+	for (auto& pass : passes) {
+		Collect(pass);
+	}
+}
+
+void GameEngine::GpuProfiler::Begin(const std::string& name)
+{
+	size_t index = 0;
+	while (index < passes.size() && passes[index].name != name) {
+		index++;
+	}
+
+	// First time the pass is measured
+	if (index == passes.size()) {
+		Pass pass = {};
+		pass.name = name;
+		glGenQueries(bufferedFrames * 2, &pass.queries[0][0]);
+		passes.push_back(pass);
+	}
+
+	unsigned int slot = frame % bufferedFrames;
+	glQueryCounter(passes[index].queries[slot][0], GL_TIMESTAMP);
+	stack.push_back(index);
+}
+
+void GameEngine::GpuProfiler::End()
+{
+	if (stack.empty()) return;
+
+	unsigned int slot = frame % bufferedFrames;
+	Pass& pass = passes[stack.back()];
+	glQueryCounter(pass.queries[slot][1], GL_TIMESTAMP);
+	pass.issued[slot] = true;
+	stack.pop_back();
+}
+
+size_t GameEngine::GpuProfiler::PassCount() const
+{
+	return passes.size();
+}
+
+const std::string& GameEngine::GpuProfiler::PassName(const size_t index) const
+{
+	return passes[index].name;
+}
+
+double GameEngine::GpuProfiler::AverageMs(const size_t index) const
+{
+	const Pass& pass = passes[index];
+	return pass.sampleCount == 0 ? 0 : pass.sum / pass.sampleCount;
+}
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <string>
+
+#include <Core/Engine.h>
+
+namespace GameEngine {
+	/// <summary>
+	/// Measures the GPU time of the render passes, using timestamp queries.
+	/// The queries of a frame are read a few frames later (when the GPU is done with them),
+	/// so the profiler never waits for the GPU. The times are averaged over the last frames.
+	/// </summary>
+	class GpuProfiler {
+	public:
+		/// <summary>
+		/// How many frames are in flight (the results of a frame are read after this many frames)
+		/// </summary>
+		static const unsigned int bufferedFrames = 3;
+
+		/// <summary>
+		/// How many frames are averaged
+		/// </summary>
+		static const unsigned int averagedFrames = 60;
+
+		GpuProfiler();
+		~GpuProfiler();
+
+		/// <summary>
+		/// Start a new frame, collecting the results of the oldest frame in flight
+		/// </summary>
+		void BeginFrame();
+
+		/// <summary>
+		/// Start measuring a pass. Passes can be nested, but each must be measured only once per frame.
+		/// </summary>
+		/// <param name="name">The name of the pass</param>
+		void Begin(const std::string& name);
+
+		/// <summary>
+		/// Stop measuring the last started pass
+		/// </summary>
+		void End();
+
+		/// <summary>
+		/// Get the number of passes measured so far
+		/// </summary>
+		size_t PassCount() const;
+
+		/// <summary>
+		/// Get the name of a pass
+		/// </summary>
+		/// <param name="index">The index of the pass (in the order they were first measured)</param>
+		const std::string& PassName(const size_t index) const;
+
+		/// <summary>
+		/// Get the average GPU time of a pass, in milliseconds
+		/// </summary>
+		/// <param name="index">The index of the pass</param>
+		double AverageMs(const size_t index) const;
+
+	private:
+		struct Pass {
+			std::string name;
+			GLuint queries[bufferedFrames][2];	// Start and end timestamps, for every frame in flight
+			bool issued[bufferedFrames];
+
+			double samples[averagedFrames];		// The last times, in milliseconds
+			unsigned int sampleCount;
+			unsigned int nextSample;
+			double sum;
+		};
+
+		std::vector<Pass> passes;
+		std::vector<size_t> stack;	// The passes that were started, but not ended
+		unsigned int frame;
+
+		/// <summary>
+		/// Read the results of a pass for the current frame slot, if they are available
+		/// </summary>
+		void Collect(Pass& pass);
+	};
+}
\ No newline at end of file
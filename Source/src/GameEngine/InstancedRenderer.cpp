@@ -0,0 +1,152 @@
+#include "InstancedRenderer.hpp"
+
+#include <cstddef>
+#include "Transform.hpp"
+
+GameEngine::InstancedRenderer::InstancedRenderer() {}
+
+GameEngine::InstancedRenderer::~InstancedRenderer()
+{
+	for (auto& entry : instanceBuffers) {
+		glDeleteBuffers(1, &entry.second.vbo);
+	}
+}
+
+void GameEngine::InstancedRenderer::Register(Shader* shader, Shader* instancedShader)
+{
+	instancedShaders[shader] = instancedShader;
+}
+
+bool GameEngine::InstancedRenderer::Add(const TransformComponent& transform, const RenderComponent& render)
+{
+	if (render.mesh == nullptr || render.shader == nullptr || !render.isRendered) return true;
+
+	Shader* shader = GetInstancedShader(render);
+	if (shader == nullptr) return false;
+
+	Add(render.mesh, shader, render.hasTexture ? render.texture : nullptr, MakeInstance(transform, render));
+	return true;
+}
+
+Shader* GameEngine::InstancedRenderer::GetInstancedShader(const RenderComponent& render) const
+{
+	// Objects with emission maps or distortion use uniforms that can't be instanced
+	if (render.emissionMaps[0] != nullptr || render.distortedTime > 0) return nullptr;
+
+	auto shader = instancedShaders.find(render.shader);
+	return shader == instancedShaders.end() ? nullptr : shader->second;
+}
+
+GameEngine::InstanceData GameEngine::InstancedRenderer::MakeInstance(const TransformComponent& transform, const RenderComponent& render)
+{
+	InstanceData instance;
+	instance.model = Scale(Translate(glm::mat4(1), transform.position), transform.scale);
+	instance.emmisive = render.material.emmisive;
+	instance.ambient = render.material.ambient;
+	instance.shininess = render.material.shininess;
+	return instance;
+}
+
+void GameEngine::InstancedRenderer::Add(Mesh* mesh, Shader* instancedShader, Texture2D* texture, const InstanceData& instance)
+{
+	// Find the batch of the object (there are only a few, so a linear search is enough)
+	Batch* batch = nullptr;
+	for (auto& current : batches) {
+		if (current.mesh == mesh && current.shader == instancedShader && current.texture == texture) {
+			batch = &current;
+			break;
+		}
+	}
+
+	if (batch == nullptr) {
+		batches.push_back({ mesh, instancedShader, texture, {} });
+		batch = &batches.back();
+	}
+
+	batch->instances.push_back(instance);
+}
+
+GameEngine::InstancedRenderer::InstanceBuffer& GameEngine::InstancedRenderer::GetInstanceBuffer(Mesh* mesh)
+{
+	auto it = instanceBuffers.find(mesh);
+	if (it != instanceBuffers.end()) return it->second;
+
+	InstanceBuffer& buffer = instanceBuffers[mesh];
+	buffer.capacity = 64;
+
+	glBindVertexArray(mesh->GetBuffers()->VAO);
+	glGenBuffers(1, &buffer.vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo);
+	glBufferData(GL_ARRAY_BUFFER, buffer.capacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+
+	// The model matrix takes 4 locations, one for every column
+	for (GLuint i = 0; i < 4; ++i) {
+		glEnableVertexAttribArray(firstAttribute + i);
+		glVertexAttribPointer(firstAttribute + i, 4, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)(offsetof(InstanceData, model) + i * sizeof(glm::vec4)));
+		glVertexAttribDivisor(firstAttribute + i, 1);
+	}
+
+	glEnableVertexAttribArray(firstAttribute + 4);
+	glVertexAttribPointer(firstAttribute + 4, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, emmisive));
+	glVertexAttribDivisor(firstAttribute + 4, 1);
+
+	glEnableVertexAttribArray(firstAttribute + 5);
+	glVertexAttribPointer(firstAttribute + 5, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, ambient));
+	glVertexAttribDivisor(firstAttribute + 5, 1);
+
+	glEnableVertexAttribArray(firstAttribute + 6);
+	glVertexAttribPointer(firstAttribute + 6, 1, GL_FLOAT, GL_FALSE, sizeof(InstanceData), (void*)offsetof(InstanceData, shininess));
+	glVertexAttribDivisor(firstAttribute + 6, 1);
+
+	glBindVertexArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+	return buffer;
+}
+
+void GameEngine::InstancedRenderer::Render(Camera* camera, RenderStats& stats)
+{
+	glm::mat4 view = camera->GetViewMatrix();
+	glm::vec3 cameraPos = camera->position;
+
+	for (auto& batch : batches) {
+		if (batch.instances.empty()) continue;
+
+		Shader* shader = batch.shader;
+		glUseProgram(shader->program);
+		stats.programSwitches++;
+
+		// Bind VP and Camera Data (the lights are in the shared light buffer)
+		glUniformMatrix4fv(shader->loc_view_matrix, 1, GL_FALSE, glm::value_ptr(view));
+		glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(camera->projectionMatrix));
+		glUniform3fv(shader->loc_eye_pos, 1, glm::value_ptr(cameraPos));
+		const ShaderUniforms& uniforms = ShaderUniforms::Get(shader);
+
+		// Bind Texture Data
+		if (batch.texture != nullptr) {
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, batch.texture->GetTextureID());
+			glUniform1i(uniforms.texture1, 0);
+			stats.textureSwitches++;
+		}
+		glUniform1i(uniforms.has_texture, batch.texture != nullptr);
+		glUniform1f(uniforms.time, (GLfloat)Engine::GetElapsedTime());
+
+		// Upload the instances, growing the buffer if needed (orphaning the old storage otherwise)
+		InstanceBuffer& buffer = GetInstanceBuffer(batch.mesh);
+		size_t count = batch.instances.size();
+		glBindBuffer(GL_ARRAY_BUFFER, buffer.vbo);
+		while (buffer.capacity < count) buffer.capacity *= 2;
+		glBufferData(GL_ARRAY_BUFFER, buffer.capacity * sizeof(InstanceData), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(InstanceData), batch.instances.data());
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+		glBindVertexArray(batch.mesh->GetBuffers()->VAO);
+		glDrawElementsInstanced(batch.mesh->GetDrawMode(), static_cast<int>(batch.mesh->indices.size()), GL_UNSIGNED_SHORT, 0, (GLsizei)count);
+		stats.vaoSwitches++;
+		stats.drawCalls++;
+
+		batch.instances.clear();
+	}
+	glBindVertexArray(0);
+}
\ No newline at end of file
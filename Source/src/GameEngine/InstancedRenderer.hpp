@@ -0,0 +1,111 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+
+#include <Core/Engine.h>
+#include "Camera.hpp"
+#include "Components.hpp"
+#include "ShaderUniforms.hpp"
+#include "RenderQueue.hpp"
+
+namespace GameEngine {
+	/// <summary>
+	/// The per-instance data, as it is stored in the instance buffer
+	/// </summary>
+	struct InstanceData {
+		glm::mat4 model;
+		glm::vec3 emmisive;
+		glm::vec3 ambient;
+		float shininess;
+	};
+
+	/// <summary>
+	/// Draws the objects that share the same mesh, shader and texture (platforms, obstacles,
+	/// planets) with a single instanced draw call. The model matrix and the material of every
+	/// object are uploaded in a per-mesh instance buffer, instead of being set as uniforms
+	/// before every draw call.
+	/// </summary>
+	class InstancedRenderer {
+	public:
+		/// <summary>
+		/// The first attribute location used by the instance data (the model matrix uses 4 locations)
+		/// </summary>
+		static const GLuint firstAttribute = 4;
+
+		InstancedRenderer();
+		~InstancedRenderer();
+
+		/// <summary>
+		/// Set the instanced version of a shader. Only the objects using a registered
+		/// shader are drawn using instancing.
+		/// </summary>
+		/// <param name="shader">The shader used by the objects</param>
+		/// <param name="instancedShader">The instanced version of the shader</param>
+		void Register(Shader* shader, Shader* instancedShader);
+
+		/// <summary>
+		/// Queue an object to be drawn in the next call to Render
+		/// </summary>
+		/// <param name="transform">The transform of the object</param>
+		/// <param name="render">The render data of the object</param>
+		/// <returns>False if the object can't be instanced (and must be rendered separately)</returns>
+		bool Add(const TransformComponent& transform, const RenderComponent& render);
+
+		/// <summary>
+		/// Get the shader an object is drawn with, if it is instanced. It only reads the registered
+		/// shaders, so it can be called from any thread (but not while a shader is registered).
+		/// </summary>
+		/// <param name="render">The render data of the object</param>
+		/// <returns>The instanced shader, or null if the object can't be instanced</returns>
+		Shader* GetInstancedShader(const RenderComponent& render) const;
+
+		/// <summary>
+		/// Create the instance data of an object (without any OpenGL call)
+		/// </summary>
+		/// <param name="transform">The transform of the object</param>
+		/// <param name="render">The render data of the object</param>
+		/// <returns>The instance data</returns>
+		static InstanceData MakeInstance(const TransformComponent& transform, const RenderComponent& render);
+
+		/// <summary>
+		/// Queue an instance, recorded before, to be drawn in the next call to Render
+		/// </summary>
+		/// <param name="mesh">The mesh of the object</param>
+		/// <param name="instancedShader">The instanced shader (see GetInstancedShader)</param>
+		/// <param name="texture">The texture of the object (null if it has none)</param>
+		/// <param name="instance">The instance data</param>
+		void Add(Mesh* mesh, Shader* instancedShader, Texture2D* texture, const InstanceData& instance);
+
+		/// <summary>
+		/// Draw all the queued objects, one draw call for every batch, and clear the batches
+		/// </summary>
+		/// <param name="camera">The camera</param>
+		/// <param name="stats">The stats where the state changes are added</param>
+		void Render(Camera* camera, RenderStats& stats);
+
+	private:
+		struct Batch {
+			Mesh* mesh;
+			Shader* shader;
+			Texture2D* texture;
+			std::vector<InstanceData> instances;
+		};
+
+		struct InstanceBuffer {
+			GLuint vbo;
+			size_t capacity;	// In instances
+		};
+
+		std::unordered_map<const Shader*, Shader*> instancedShaders;
+		std::unordered_map<const Mesh*, InstanceBuffer> instanceBuffers;
+
+		// The batches are kept between frames, so their vectors are reused
+		std::vector<Batch> batches;
+
+		/// <summary>
+		/// Get the instance buffer of a mesh, creating it (and attaching it to the VAO of the mesh) on first use
+		/// </summary>
+		InstanceBuffer& GetInstanceBuffer(Mesh* mesh);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,145 @@
+#include "JobSystem.hpp"
+
+namespace {
+	// The job system the current thread is a worker of, and the index of its queue
+	thread_local const GameEngine::JobSystem* currentSystem = nullptr;
+	thread_local unsigned int currentQueue = 0;
+}
+
+GameEngine::JobSystem::JobSystem(unsigned int threadCount) : queuedJobs(0), sleepingWorkers(0), stopping(false)
+{
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	for (unsigned int i = 0; i < threadCount; ++i) {
+		queues.push_back(std::unique_ptr<Queue>(new Queue()));
+	}
+
+	// The calling thread uses the first queue
+	for (unsigned int i = 1; i < threadCount; ++i) {
+		workers.push_back(std::thread(&JobSystem::Work, this, i));
+	}
+}
+
+GameEngine::JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping = true;
+	}
+	jobAdded.notify_all();
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+unsigned int GameEngine::JobSystem::ThreadCount() const
+{
+	return (unsigned int)queues.size();
+}
+
+unsigned int GameEngine::JobSystem::CurrentQueue() const
+{
+	return currentSystem == this ? currentQueue : 0;
+}
+
+void GameEngine::JobSystem::Schedule(const Job& job)
+{
+	job.counter->pending.fetch_add(1, std::memory_order_relaxed);
+
+	Queue& queue = *queues[CurrentQueue()];
+	bool added = false;
+	{
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.back - queue.front < queueCapacity) {
+			queue.jobs[queue.back % queueCapacity] = job;
+			queue.back++;
+			queuedJobs++;
+			added = true;
+		}
+	}
+
+	if (!added) {
+		// The queue is full - run the job now
+		Execute(job);
+		return;
+	}
+
+	// Wake up a worker, if they are all sleeping (the lock makes sure it's already waiting)
+	if (sleepingWorkers > 0) {
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		jobAdded.notify_one();
+	}
+}
+
+void GameEngine::JobSystem::Wait(JobCounter& counter)
+{
+	unsigned int self = CurrentQueue();
+	while (!counter.IsDone()) {
+		Job job;
+		if (FindJob(self, job)) {
+			Execute(job);
+		}
+		else {
+			// The remaining jobs are running on other threads
+			std::this_thread::yield();
+		}
+	}
+}
+
+bool GameEngine::JobSystem::FindJob(const unsigned int self, Job& job)
+{
+	// The newest job of the own queue
+	{
+		Queue& queue = *queues[self];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.back != queue.front) {
+			queue.back--;
+			job = queue.jobs[queue.back % queueCapacity];
+			queuedJobs--;
+			return true;
+		}
+	}
+
+	// The oldest job of another queue
+	for (size_t i = 1; i < queues.size(); ++i) {
+		Queue& queue = *queues[(self + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+		if (queue.back != queue.front) {
+			job = queue.jobs[queue.front % queueCapacity];
+			queue.front++;
+			queuedJobs--;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void GameEngine::JobSystem::Execute(const Job& job)
+{
+	job.function(job.data, job.begin, job.end);
+	job.counter->pending.fetch_sub(1, std::memory_order_release);
+}
+
+void GameEngine::JobSystem::Work(const unsigned int index)
+{
+	currentSystem = this;
+	currentQueue = index;
+
+	while (true) {
+		Job job;
+		if (FindJob(index, job)) {
+			Execute(job);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex);
+		sleepingWorkers++;
+		jobAdded.wait(lock, [this] { return stopping || queuedJobs > 0; });
+		sleepingWorkers--;
+		if (stopping) return;
+	}
+}
\ No newline at end of file
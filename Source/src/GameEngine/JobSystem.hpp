@@ -0,0 +1,152 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <algorithm>
+
+namespace GameEngine {
+	/// <summary>
+	/// Counts the scheduled jobs that didn't finish yet. Work that depends on some jobs waits
+	/// for their counter (JobSystem::Wait) before it starts.
+	/// </summary>
+	struct JobCounter {
+		std::atomic<unsigned int> pending;
+
+		JobCounter() : pending(0) {}
+
+		bool IsDone() const {
+			return pending.load(std::memory_order_acquire) == 0;
+		}
+	};
+
+	/// <summary>
+	/// A function that is run on a range of items (for example, a range of entities)
+	/// </summary>
+	struct Job {
+		void (*function)(void* data, size_t begin, size_t end);
+		void* data;
+		size_t begin, end;
+		JobCounter* counter;	// Decremented when the job finishes
+	};
+
+	/// <summary>
+	/// Runs jobs on a pool of worker threads. Every thread has its own queue: it takes the jobs
+	/// it scheduled from the back of its queue (the most recent ones, still in its cache), and
+	/// when its queue is empty it steals the oldest jobs from the front of the other queues.
+	/// The thread that created the system (or any other thread that is not a worker) uses the
+	/// first queue, and it runs jobs too while it waits for them. Scheduling doesn't allocate memory.
+	/// </summary>
+	class JobSystem {
+	public:
+		/// <summary>
+		/// The maximum number of jobs waiting in a queue (when it's full, the jobs are run right away)
+		/// </summary>
+		static const size_t queueCapacity = 1024;
+
+		/// <summary>
+		/// Start the worker threads
+		/// </summary>
+		/// <param name="threadCount">The number of threads that run jobs, including the calling thread
+		/// (0 - one for every hardware thread, 1 - the jobs run on the calling thread only)</param>
+		explicit JobSystem(unsigned int threadCount = 0);
+		~JobSystem();
+
+		/// <summary>
+		/// Get the number of threads that run jobs (the workers and the calling thread)
+		/// </summary>
+		unsigned int ThreadCount() const;
+
+		/// <summary>
+		/// Add a job to the queue of the current thread. The counter of the job is incremented.
+		/// </summary>
+		/// <param name="job">The job</param>
+		void Schedule(const Job& job);
+
+		/// <summary>
+		/// Wait for all the jobs of a counter to finish, running jobs in the meantime
+		/// </summary>
+		/// <param name="counter">The counter</param>
+		void Wait(JobCounter& counter);
+
+		/// <summary>
+		/// Run a function on all the items of a range, split in blocks that are run in parallel.
+		/// Returns when all the blocks are done. The calling thread runs the first block.
+		/// When the range is not split (it has at most "grain" items, or there is a single thread),
+		/// the function is called once, with the whole range - which can be larger than a block.
+		/// </summary>
+		/// <param name="count">The number of items</param>
+		/// <param name="grain">The number of items in a block</param>
+		/// <param name="function">Called as function(begin, end) for every block (begin is a multiple of grain)</param>
+		template <typename Function>
+		void ParallelFor(const size_t count, const size_t grain, const Function& function) {
+			if (count <= grain || queues.size() == 1) {
+				if (count > 0) function((size_t)0, count);
+				return;
+			}
+
+			JobCounter counter;
+			Job job;
+			job.function = &Invoke<Function>;
+			job.data = (void*)&function;
+			job.counter = &counter;
+			for (size_t begin = grain; begin < count; begin += grain) {
+				job.begin = begin;
+				job.end = std::min(begin + grain, count);
+				Schedule(job);
+			}
+
+			function((size_t)0, grain);
+			Wait(counter);
+		}
+
+	private:
+		struct Queue {
+			std::mutex mutex;
+			Job jobs[queueCapacity];	// A ring buffer
+			size_t front = 0;			// The oldest job (stolen first)
+			size_t back = 0;			// After the newest job
+		};
+
+		std::vector<std::unique_ptr<Queue>> queues;		// The first one is used by the threads that are not workers
+		std::vector<std::thread> workers;
+		std::atomic<int> queuedJobs;
+		std::atomic<int> sleepingWorkers;
+		bool stopping;
+
+		std::mutex sleepMutex;		// Only used to put the idle workers to sleep
+		std::condition_variable jobAdded;
+
+		template <typename Function>
+		static void Invoke(void* data, size_t begin, size_t end) {
+			(*(const Function*)data)(begin, end);
+		}
+
+		/// <summary>
+		/// Get the index of the queue of the current thread
+		/// </summary>
+		unsigned int CurrentQueue() const;
+
+		/// <summary>
+		/// Take a job from the own queue, or steal one from another queue
+		/// </summary>
+		/// <param name="self">The queue of the current thread</param>
+		/// <param name="job">Where the job is copied</param>
+		/// <returns>False if there are no jobs</returns>
+		bool FindJob(const unsigned int self, Job& job);
+
+		/// <summary>
+		/// Run a job and mark it as finished
+		/// </summary>
+		void Execute(const Job& job);
+
+		/// <summary>
+		/// The loop of a worker thread
+		/// </summary>
+		/// <param name="index">The index of the queue of the worker</param>
+		void Work(const unsigned int index);
+	};
+}
\ No newline at end of file
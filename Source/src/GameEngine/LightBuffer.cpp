@@ -0,0 +1,59 @@
+#include "LightBuffer.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+GameEngine::LightBuffer::LightBuffer() : ubo(0), data() {}
+
+GameEngine::LightBuffer::~LightBuffer()
+{
+	if (ubo != 0) {
+		glDeleteBuffers(1, &ubo);
+	}
+}
+
+void GameEngine::LightBuffer::Init()
+{
+	glGenBuffers(1, &ubo);
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	glBufferData(GL_UNIFORM_BUFFER, sizeof(LightBlockStd140), nullptr, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+	glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, ubo);
+}
+
+void GameEngine::LightBuffer::Update(const std::vector<Light>& lights)
+{
+	int count = std::min((int)lights.size(), ShaderConstants::maxLightSources);
+	data.lights_count = count;
+
+	for (int i = 0; i < count; ++i) {
+		const Light& light = lights[i];
+		LightStd140& dest = data.lights[i];
+		dest.type = (GLint)light.type;
+		dest.position = light.position;
+		dest.direction = light.direction;
+		dest.ambient = light.ambient;
+		dest.diffuse = light.diffuse;
+		dest.specular = light.specular;
+		dest.constant = light.constant;
+		dest.linear = light.linear;
+		dest.quadratic = light.quadratic;
+		dest.cutOff = light.cutOff;
+		dest.outerCutOff = light.outerCutOff;
+	}
+
+	// Only upload the lights that are used
+	GLsizeiptr size = offsetof(LightBlockStd140, lights) + count * sizeof(LightStd140);
+	glBindBuffer(GL_UNIFORM_BUFFER, ubo);
+	glBufferSubData(GL_UNIFORM_BUFFER, 0, size, &data);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+
+void GameEngine::LightBuffer::BindShader(const Shader* shader)
+{
+	GLuint blockIndex = glGetUniformBlockIndex(shader->program, "Lights");
+	if (blockIndex != GL_INVALID_INDEX) {
+		glUniformBlockBinding(shader->program, blockIndex, bindingPoint);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+
+#include <Core/Engine.h>
+#include "Lighting.hpp"
+#include "ShaderUniforms.hpp"
+
+namespace GameEngine {
+	/// <summary>
+	/// A Light, with the std140 memory layout (as it is stored in the uniform buffer)
+	/// </summary>
+	struct LightStd140 {
+		GLint type;
+		GLint _pad0[3];
+		glm::vec3 position;
+		GLfloat _pad1;
+		glm::vec3 direction;
+		GLfloat _pad2;
+		glm::vec3 ambient;
+		GLfloat _pad3;
+		glm::vec3 diffuse;
+		GLfloat _pad4;
+		glm::vec3 specular;
+		GLfloat constant;		// Packed after the vec3, in its padding
+		GLfloat linear;
+		GLfloat quadratic;
+		GLfloat cutOff;
+		GLfloat outerCutOff;
+	};
+
+	/// <summary>
+	/// The "Lights" uniform block, with the std140 memory layout
+	/// </summary>
+	struct LightBlockStd140 {
+		GLint lights_count;
+		GLint _pad0[3];
+		LightStd140 lights[ShaderConstants::maxLightSources];
+	};
+
+	static_assert(sizeof(LightStd140) == 112, "LightStd140 doesn't match the std140 layout");
+	static_assert(sizeof(LightBlockStd140) == 16 + 112 * ShaderConstants::maxLightSources, "LightBlockStd140 doesn't match the std140 layout");
+
+	/// <summary>
+	/// A uniform buffer that holds the lights of the scene. It is shared by all the shaders
+	/// that use the "Lights" uniform block, so the lights are uploaded once per frame
+	/// instead of once for every object.
+	/// </summary>
+	class LightBuffer {
+	public:
+		/// <summary>
+		/// The binding point of the "Lights" uniform block
+		/// </summary>
+		static const GLuint bindingPoint = 0;
+
+		LightBuffer();
+		~LightBuffer();
+
+		/// <summary>
+		/// Create the buffer and attach it to the binding point
+		/// </summary>
+		void Init();
+
+		/// <summary>
+		/// Upload the lights of the current frame
+		/// </summary>
+		/// <param name="lights">The lights (only the first maxLightSources are used)</param>
+		void Update(const std::vector<Light>& lights);
+
+		/// <summary>
+		/// Link the "Lights" uniform block of a shader to the binding point of the buffer.
+		/// Shaders without the block are ignored.
+		/// </summary>
+		/// <param name="shader">The shader</param>
+		static void BindShader(const Shader* shader);
+
+	private:
+		GLuint ubo;
+		LightBlockStd140 data;
+	};
+}
\ No newline at end of file
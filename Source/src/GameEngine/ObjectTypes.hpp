@@ -0,0 +1,72 @@
+#pragma once
+
+namespace GameEngine {
+	/// <summary>
+	/// The category of a game object
+	/// </summary>
+	enum class ObjectCategory : unsigned char { Undefined, Player, Platform, Obstacle, Planet, Star, Sphere, Skybox };
+
+	/// <summary>
+	/// The color of a platform (it also defines the effect the platform has on the player)
+	/// </summary>
+	enum class PlatformColor : unsigned char { Red, Green, Yellow, Orange, Purple, Blue, White, Count };
+
+	/// <summary>
+	/// The kind of an obstacle - good ones give points, bad ones take a life
+	/// </summary>
+	enum class ObstacleKind : unsigned char { Good, Bad };
+
+	/// <summary>
+	/// The type of a game object. It is made of a category and a variant
+	/// (the color of a platform, the kind of obstacle, the texture of a planet or star), so it can be compared
+	/// and dispatched on without any string operations.
+	/// </summary>
+	struct ObjectType {
+		ObjectCategory category = ObjectCategory::Undefined;
+		unsigned char variant = 0;
+
+		ObjectType() = default;
+		ObjectType(const ObjectCategory category, const unsigned char variant = 0) : category(category), variant(variant) {}
+
+		static ObjectType Platform(const PlatformColor color) {
+			return ObjectType(ObjectCategory::Platform, (unsigned char)color);
+		}
+
+		static ObjectType Obstacle(const ObstacleKind kind) {
+			return ObjectType(ObjectCategory::Obstacle, (unsigned char)kind);
+		}
+
+		/// <summary>
+		/// Check if the type is part of a category
+		/// </summary>
+		/// <param name="other">The category</param>
+		/// <returns>If the type is part of that category</returns>
+		bool is(const ObjectCategory other) const {
+			return category == other;
+		}
+
+		/// <summary>
+		/// Get the color of a platform. Only valid for platforms.
+		/// </summary>
+		/// <returns>The color</returns>
+		PlatformColor platformColor() const {
+			return (PlatformColor)variant;
+		}
+
+		/// <summary>
+		/// Get the kind of an obstacle. Only valid for obstacles.
+		/// </summary>
+		/// <returns>The kind of obstacle</returns>
+		ObstacleKind obstacleKind() const {
+			return (ObstacleKind)variant;
+		}
+
+		bool operator==(const ObjectType& other) const {
+			return category == other.category && variant == other.variant;
+		}
+
+		bool operator!=(const ObjectType& other) const {
+			return !(*this == other);
+		}
+	};
+}
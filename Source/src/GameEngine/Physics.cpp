@@ -2,6 +2,15 @@
 
 #include <iostream>
 
+// Select the SIMD instructions used by the batch integrator
+#if defined(__AVX2__)
+#define PHYSICS_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PHYSICS_SSE
+#include <emmintrin.h>
+#endif
+
 using namespace GameEngine;
 
 double PhysixEngine::current_time = 0.f;
@@ -82,6 +91,172 @@ void PhysixEngine::UpdateTime(const double deltaTime) {
 	current_time += deltaTime;
 }
 
+void BodyBatch::Resize(const size_t count)
+{
+	px.resize(count); py.resize(count); pz.resize(count);
+	vx.resize(count); vy.resize(count); vz.resize(count);
+	drag_coef.resize(count);
+	gravity_coef.resize(count);
+}
+
+void BodyBatch::Load(const size_t index, const State& state)
+{
+	px[index] = state.x.x; py[index] = state.x.y; pz[index] = state.x.z;
+	vx[index] = state.v.x; vy[index] = state.v.y; vz[index] = state.v.z;
+	drag_coef[index] = (float)state.drag_coef;
+	gravity_coef[index] = (float)state.gravity_coef;
+}
+
+void BodyBatch::Store(const size_t index, State& state) const
+{
+	state.x = glm::vec3(px[index], py[index], pz[index]);
+	state.v = glm::vec3(vx[index], vy[index], vz[index]);
+}
+
+size_t BodyBatch::Size() const
+{
+	return px.size();
+}
+
+/// <summary>
+/// Integrate the bodies in the [start, end) range, one at a time
+/// </summary>
+static void IntegrateBatchScalar(BodyBatch& b, size_t start, size_t end, float h, bool RK4)
+{
+	const float G = (float)PhysicsConstants::G_CONSTANT;
+
+	for (size_t i = start; i < end; ++i) {
+		float k = b.drag_coef[i];
+		float g = -G * b.gravity_coef[i];
+
+		if (RK4) {
+			// X axis - the acceleration depends on the velocity (drag), so all 4 stages are needed
+			float v_a = b.vx[i], dv_a = -k * v_a;
+			float v_b = v_a + dv_a * h * 0.5f, dv_b = -k * v_b;
+			float v_c = v_a + dv_b * h * 0.5f, dv_c = -k * v_c;
+			float v_d = v_a + dv_c * h, dv_d = -k * v_d;
+			b.px[i] += h / 6.f * (v_a + 2.f * (v_b + v_c) + v_d);
+			b.vx[i] += h / 6.f * (dv_a + 2.f * (dv_b + dv_c) + dv_d);
+
+			// Y axis - constant acceleration (gravity), RK4 reduces to the exact solution
+			b.py[i] += h * (b.vy[i] + g * h * 0.5f);
+			b.vy[i] += g * h;
+		}
+		else {
+			b.px[i] += b.vx[i] * h;
+			b.vx[i] += -k * b.vx[i] * h;
+			b.py[i] += b.vy[i] * h;
+			b.vy[i] += g * h;
+		}
+
+		// Z axis - no acceleration
+		b.pz[i] += b.vz[i] * h;
+	}
+}
+
+void PhysixEngine::IntegrateBatch(BodyBatch& b, float h, bool RK4)
+{
+	IntegrateBatch(b, 0, b.Size(), h, RK4);
+}
+
+void PhysixEngine::IntegrateBatch(BodyBatch& b, size_t start, size_t end, float h, bool RK4)
+{
+	size_t count = end;
+	size_t i = start;
+	const float G = (float)PhysicsConstants::G_CONSTANT;
+
+#if defined(PHYSICS_AVX2)
+	const __m256 vh = _mm256_set1_ps(h);
+	const __m256 vhalf_h = _mm256_set1_ps(h * 0.5f);
+	const __m256 vsixth_h = _mm256_set1_ps(h / 6.f);
+	const __m256 vtwo = _mm256_set1_ps(2.f);
+	const __m256 vminus_g = _mm256_set1_ps(-G);
+	const __m256 vzero = _mm256_setzero_ps();
+
+	for (; i + 8 <= count; i += 8) {
+		__m256 nk = _mm256_sub_ps(vzero, _mm256_loadu_ps(&b.drag_coef[i]));
+		__m256 g = _mm256_mul_ps(vminus_g, _mm256_loadu_ps(&b.gravity_coef[i]));
+		__m256 px = _mm256_loadu_ps(&b.px[i]), vx = _mm256_loadu_ps(&b.vx[i]);
+		__m256 py = _mm256_loadu_ps(&b.py[i]), vy = _mm256_loadu_ps(&b.vy[i]);
+		__m256 pz = _mm256_loadu_ps(&b.pz[i]), vz = _mm256_loadu_ps(&b.vz[i]);
+
+		if (RK4) {
+			__m256 dv_a = _mm256_mul_ps(nk, vx);
+			__m256 v_b = _mm256_add_ps(vx, _mm256_mul_ps(dv_a, vhalf_h));
+			__m256 dv_b = _mm256_mul_ps(nk, v_b);
+			__m256 v_c = _mm256_add_ps(vx, _mm256_mul_ps(dv_b, vhalf_h));
+			__m256 dv_c = _mm256_mul_ps(nk, v_c);
+			__m256 v_d = _mm256_add_ps(vx, _mm256_mul_ps(dv_c, vh));
+			__m256 dv_d = _mm256_mul_ps(nk, v_d);
+
+			__m256 dx = _mm256_add_ps(_mm256_add_ps(vx, v_d), _mm256_mul_ps(vtwo, _mm256_add_ps(v_b, v_c)));
+			__m256 dv = _mm256_add_ps(_mm256_add_ps(dv_a, dv_d), _mm256_mul_ps(vtwo, _mm256_add_ps(dv_b, dv_c)));
+			px = _mm256_add_ps(px, _mm256_mul_ps(vsixth_h, dx));
+			vx = _mm256_add_ps(vx, _mm256_mul_ps(vsixth_h, dv));
+
+			py = _mm256_add_ps(py, _mm256_mul_ps(vh, _mm256_add_ps(vy, _mm256_mul_ps(g, vhalf_h))));
+		}
+		else {
+			px = _mm256_add_ps(px, _mm256_mul_ps(vx, vh));
+			vx = _mm256_add_ps(vx, _mm256_mul_ps(_mm256_mul_ps(nk, vx), vh));
+			py = _mm256_add_ps(py, _mm256_mul_ps(vy, vh));
+		}
+		vy = _mm256_add_ps(vy, _mm256_mul_ps(g, vh));
+		pz = _mm256_add_ps(pz, _mm256_mul_ps(vz, vh));
+
+		_mm256_storeu_ps(&b.px[i], px); _mm256_storeu_ps(&b.vx[i], vx);
+		_mm256_storeu_ps(&b.py[i], py); _mm256_storeu_ps(&b.vy[i], vy);
+		_mm256_storeu_ps(&b.pz[i], pz);
+	}
+#elif defined(PHYSICS_SSE)
+	const __m128 vh = _mm_set1_ps(h);
+	const __m128 vhalf_h = _mm_set1_ps(h * 0.5f);
+	const __m128 vsixth_h = _mm_set1_ps(h / 6.f);
+	const __m128 vtwo = _mm_set1_ps(2.f);
+	const __m128 vminus_g = _mm_set1_ps(-G);
+	const __m128 vzero = _mm_setzero_ps();
+
+	for (; i + 4 <= count; i += 4) {
+		__m128 nk = _mm_sub_ps(vzero, _mm_loadu_ps(&b.drag_coef[i]));
+		__m128 g = _mm_mul_ps(vminus_g, _mm_loadu_ps(&b.gravity_coef[i]));
+		__m128 px = _mm_loadu_ps(&b.px[i]), vx = _mm_loadu_ps(&b.vx[i]);
+		__m128 py = _mm_loadu_ps(&b.py[i]), vy = _mm_loadu_ps(&b.vy[i]);
+		__m128 pz = _mm_loadu_ps(&b.pz[i]), vz = _mm_loadu_ps(&b.vz[i]);
+
+		if (RK4) {
+			__m128 dv_a = _mm_mul_ps(nk, vx);
+			__m128 v_b = _mm_add_ps(vx, _mm_mul_ps(dv_a, vhalf_h));
+			__m128 dv_b = _mm_mul_ps(nk, v_b);
+			__m128 v_c = _mm_add_ps(vx, _mm_mul_ps(dv_b, vhalf_h));
+			__m128 dv_c = _mm_mul_ps(nk, v_c);
+			__m128 v_d = _mm_add_ps(vx, _mm_mul_ps(dv_c, vh));
+			__m128 dv_d = _mm_mul_ps(nk, v_d);
+
+			__m128 dx = _mm_add_ps(_mm_add_ps(vx, v_d), _mm_mul_ps(vtwo, _mm_add_ps(v_b, v_c)));
+			__m128 dv = _mm_add_ps(_mm_add_ps(dv_a, dv_d), _mm_mul_ps(vtwo, _mm_add_ps(dv_b, dv_c)));
+			px = _mm_add_ps(px, _mm_mul_ps(vsixth_h, dx));
+			vx = _mm_add_ps(vx, _mm_mul_ps(vsixth_h, dv));
+
+			py = _mm_add_ps(py, _mm_mul_ps(vh, _mm_add_ps(vy, _mm_mul_ps(g, vhalf_h))));
+		}
+		else {
+			px = _mm_add_ps(px, _mm_mul_ps(vx, vh));
+			vx = _mm_add_ps(vx, _mm_mul_ps(_mm_mul_ps(nk, vx), vh));
+			py = _mm_add_ps(py, _mm_mul_ps(vy, vh));
+		}
+		vy = _mm_add_ps(vy, _mm_mul_ps(g, vh));
+		pz = _mm_add_ps(pz, _mm_mul_ps(vz, vh));
+
+		_mm_storeu_ps(&b.px[i], px); _mm_storeu_ps(&b.vx[i], vx);
+		_mm_storeu_ps(&b.py[i], py); _mm_storeu_ps(&b.vy[i], vy);
+		_mm_storeu_ps(&b.pz[i], pz);
+	}
+#endif
+
+	// The remaining bodies (or all of them, without SIMD support)
+	IntegrateBatchScalar(b, i, count, h, RK4);
+}
+
 void RigidBody::checkVelLimits()
 {
 	if (velocity_limit == -1) return;
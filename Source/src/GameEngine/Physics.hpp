@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include <include/glm.h>
 
 /// <summary>
@@ -87,6 +89,39 @@ namespace GameEngine
 		void addImpulse(const double x,const double y, const double z);
 	};
 
+	/// <summary>
+	/// The states of many bodies, stored as packed arrays (one array for each component),
+	/// so they can be integrated together, with SIMD instructions
+	/// </summary>
+	struct BodyBatch {
+		std::vector<float> px, py, pz;
+		std::vector<float> vx, vy, vz;
+		std::vector<float> drag_coef;
+		std::vector<float> gravity_coef;
+
+		/// <summary>
+		/// Change the number of bodies in the batch
+		/// </summary>
+		/// <param name="count">The number of bodies</param>
+		void Resize(const size_t count);
+
+		/// <summary>
+		/// Copy the state of a body in the batch
+		/// </summary>
+		/// <param name="index">The index of the body in the batch</param>
+		/// <param name="state">The state</param>
+		void Load(const size_t index, const State& state);
+
+		/// <summary>
+		/// Copy the position and velocity of a body from the batch back to a state
+		/// </summary>
+		/// <param name="index">The index of the body in the batch</param>
+		/// <param name="state">The state to update</param>
+		void Store(const size_t index, State& state) const;
+
+		size_t Size() const;
+	};
+
 	class PhysixEngine
 	{
 	private:
@@ -119,6 +154,27 @@ namespace GameEngine
 		/// <param name="RK4">If RK4 integration should be used</param>
 		static void integrate(RigidBody& body, double t, float dt, bool RK4 = true);
 
+		/// <summary>
+		/// Integrate all the bodies in a batch, with the same equations as "integrate" (for simulated
+		/// bodies). It uses AVX2 or SSE instructions when they are available, and scalar code for the
+		/// bodies that remain (or when there is no SIMD support).
+		/// </summary>
+		/// <param name="batch">The bodies</param>
+		/// <param name="dt">The "deltaTime"</param>
+		/// <param name="RK4">If RK4 integration should be used (semi-implicit Euler otherwise)</param>
+		static void IntegrateBatch(BodyBatch& batch, float dt, bool RK4 = true);
+
+		/// <summary>
+		/// Integrate the bodies in the [start, end) range of a batch. Ranges that start at a multiple of 8
+		/// give the same results as integrating the whole batch, so the ranges can be integrated in parallel.
+		/// </summary>
+		/// <param name="batch">The bodies</param>
+		/// <param name="start">The first body</param>
+		/// <param name="end">After the last body</param>
+		/// <param name="dt">The "deltaTime"</param>
+		/// <param name="RK4">If RK4 integration should be used (semi-implicit Euler otherwise)</param>
+		static void IntegrateBatch(BodyBatch& batch, size_t start, size_t end, float dt, bool RK4 = true);
+
 		/// <summary>
 		/// Update the physics for the selected state
 		/// </summary>
@@ -0,0 +1,42 @@
+#include "Random.hpp"
+
+GameEngine::Random::Random() : state(0), increment(1)
+{
+	Seed(0);
+}
+
+GameEngine::Random::Random(const uint64_t seed, const uint64_t stream) : state(0), increment(1)
+{
+	Seed(seed, stream);
+}
+
+void GameEngine::Random::Seed(const uint64_t seed, const uint64_t stream)
+{
+	// The initialization of the reference implementation (pcg32_srandom_r)
+	state = 0;
+	increment = (stream << 1u) | 1u;
+	Next();
+	state += seed;
+	Next();
+}
+
+void GameEngine::Random::Fill(uint32_t* values, const size_t count)
+{
+	for (size_t i = 0; i < count; ++i) {
+		values[i] = Next();
+	}
+}
+
+void GameEngine::Random::FillBounded(uint32_t* values, const size_t count, const uint32_t bound)
+{
+	for (size_t i = 0; i < count; ++i) {
+		values[i] = Bounded(bound);
+	}
+}
+
+void GameEngine::Random::FillRange(float* values, const size_t count, const float min, const float max)
+{
+	for (size_t i = 0; i < count; ++i) {
+		values[i] = Range(min, max);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace GameEngine {
+	/// <summary>
+	/// A stream of pseudo-random numbers (PCG32). Every stream has its own state, so the systems
+	/// that use random numbers don't change each other's sequences, and a stream can be used by
+	/// another thread without any locking (as long as only one thread uses it at a time).
+	/// Streams created with the same seed and different stream ids are independent.
+	/// </summary>
+	class Random {
+	public:
+		Random();
+
+		/// <param name="seed">The seed</param>
+		/// <param name="stream">The id of the stream (the sequence used by a system)</param>
+		Random(const uint64_t seed, const uint64_t stream = 0);
+
+		/// <summary>
+		/// Restart the stream from a seed
+		/// </summary>
+		/// <param name="seed">The seed</param>
+		/// <param name="stream">The id of the stream</param>
+		void Seed(const uint64_t seed, const uint64_t stream = 0);
+
+		/// <summary>
+		/// Get the next number of the stream
+		/// </summary>
+		/// <returns>A uniformly distributed 32 bits number</returns>
+		uint32_t Next() {
+			uint64_t old = state;
+			state = old * multiplier + increment;
+			uint32_t xorShifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+			uint32_t rotation = (uint32_t)(old >> 59u);
+			return (xorShifted >> rotation) | (xorShifted << ((0u - rotation) & 31u));
+		}
+
+		/// <summary>
+		/// Get a number in [0, bound), without the bias of "Next() % bound"
+		/// </summary>
+		/// <param name="bound">The upper bound (must not be 0)</param>
+		/// <returns>The number</returns>
+		uint32_t Bounded(const uint32_t bound) {
+			// Lemire's multiply and reject method - the rejection is very rare for small bounds
+			uint64_t product = (uint64_t)Next() * bound;
+			uint32_t low = (uint32_t)product;
+			if (low < bound) {
+				uint32_t threshold = (0u - bound) % bound;
+				while (low < threshold) {
+					product = (uint64_t)Next() * bound;
+					low = (uint32_t)product;
+				}
+			}
+			return (uint32_t)(product >> 32);
+		}
+
+		/// <summary>
+		/// Get a number in [min, max)
+		/// </summary>
+		int Range(const int min, const int max) {
+			return min + (int)Bounded((uint32_t)(max - min));
+		}
+
+		/// <summary>
+		/// Get a number in [0, 1)
+		/// </summary>
+		float Float() {
+			return (Next() >> 8) * (1.f / 16777216.f);
+		}
+
+		/// <summary>
+		/// Get a number in [min, max)
+		/// </summary>
+		float Range(const float min, const float max) {
+			return min + (max - min) * Float();
+		}
+
+		/// <summary>
+		/// Get the next numbers of the stream
+		/// </summary>
+		/// <param name="values">Where the numbers are written</param>
+		/// <param name="count">How many numbers are generated</param>
+		void Fill(uint32_t* values, const size_t count);
+
+		/// <summary>
+		/// Get the next numbers in [0, bound)
+		/// </summary>
+		/// <param name="values">Where the numbers are written</param>
+		/// <param name="count">How many numbers are generated</param>
+		/// <param name="bound">The upper bound (must not be 0)</param>
+		void FillBounded(uint32_t* values, const size_t count, const uint32_t bound);
+
+		/// <summary>
+		/// Get the next numbers in [min, max)
+		/// </summary>
+		/// <param name="values">Where the numbers are written</param>
+		/// <param name="count">How many numbers are generated</param>
+		/// <param name="min">The lower bound</param>
+		/// <param name="max">The upper bound</param>
+		void FillRange(float* values, const size_t count, const float min, const float max);
+
+	private:
+		static const uint64_t multiplier = 6364136223846793005ull;
+
+		uint64_t state;
+		uint64_t increment;		// Selects the stream, always odd
+	};
+}
\ No newline at end of file
@@ -0,0 +1,176 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include "GameObject.hpp"
+#include "ShaderUniforms.hpp"
+#include "Transform.hpp"
+
+GameEngine::RenderQueue::RenderQueue() : sorting(true) {}
+
+uint64_t GameEngine::RenderQueue::ResourceId(const GLuint name)
+{
+	return std::min<uint64_t>(name, 0xFFF);
+}
+
+bool GameEngine::RenderQueue::Record(const RenderPass pass, const TransformComponent& transform, const RenderComponent& render,
+	const glm::vec3& eyePosition, const glm::vec3& viewDirection, DrawCommand& command)
+{
+	if (render.mesh == nullptr || render.shader == nullptr || !render.isRendered) return false;
+
+	// Quantize the distance along the view direction to 24 bits
+	float depth = glm::dot(transform.position - eyePosition, viewDirection);
+	depth = glm::clamp(depth / maxDepth, 0.f, 1.f);
+	uint64_t depthBits = (uint64_t)(depth * 0xFFFFFF);
+
+	// Opaque objects are drawn front-to-back, transparent ones back-to-front
+	if (pass == RenderPass::Transparent) {
+		depthBits = 0xFFFFFF - depthBits;
+	}
+
+	GLuint texture = render.hasTexture && render.texture != nullptr ? render.texture->GetTextureID() : 0;
+
+	command.key = ((uint64_t)pass << 60) | (ResourceId(render.shader->program) << 48) | (ResourceId(texture) << 36)
+		| (ResourceId(render.mesh->GetBuffers()->VAO) << 24) | depthBits;
+	command.model = Scale(Translate(glm::mat4(1), transform.position), transform.scale);
+	command.render = &render;
+	return true;
+}
+
+void GameEngine::RenderQueue::Submit(const RenderPass pass, const TransformComponent& transform, const RenderComponent& render, Camera* camera)
+{
+	DrawCommand command;
+	if (Record(pass, transform, render, camera->position, camera->forward, command)) {
+		Submit(command);
+	}
+}
+
+void GameEngine::RenderQueue::Submit(const DrawCommand& command)
+{
+	SortEntry entry;
+	entry.key = command.key;
+	entry.index = (uint32_t)packets.size();
+	entries.push_back(entry);
+	packets.push_back(command);
+}
+
+void GameEngine::RenderQueue::RadixSort()
+{
+	scratch.resize(entries.size());
+
+	for (unsigned int shift = 0; shift < 64; shift += 8) {
+		size_t counts[256] = {};
+		for (auto& entry : entries) {
+			counts[(entry.key >> shift) & 0xFF]++;
+		}
+
+		// All the keys have the same digit, the pass wouldn't change the order
+		if (counts[(entries[0].key >> shift) & 0xFF] == entries.size()) continue;
+
+		size_t offset = 0;
+		for (auto& count : counts) {
+			size_t current = count;
+			count = offset;
+			offset += current;
+		}
+
+		for (auto& entry : entries) {
+			scratch[counts[(entry.key >> shift) & 0xFF]++] = entry;
+		}
+		entries.swap(scratch);
+	}
+}
+
+void GameEngine::RenderQueue::Flush(Camera* camera, RenderStats& stats)
+{
+	if (entries.empty()) return;
+	if (sorting) RadixSort();
+
+	glm::mat4 view = camera->GetViewMatrix();
+	GLfloat time = (GLfloat)Engine::GetElapsedTime();
+
+	const Shader* currentShader = nullptr;
+	const Texture2D* currentTexture = nullptr;
+	GLuint currentVAO = 0;
+	const ShaderUniforms* uniforms = nullptr;
+
+	for (auto& entry : entries) {
+		const DrawCommand& packet = packets[entry.index];
+		const RenderComponent& render = *packet.render;
+		Shader* shader = render.shader;
+
+		// Bind the program and the data shared by all the objects that use it
+		if (shader != currentShader) {
+			currentShader = shader;
+			glUseProgram(shader->program);
+			stats.programSwitches++;
+
+			glUniformMatrix4fv(shader->loc_view_matrix, 1, GL_FALSE, glm::value_ptr(view));
+			glUniformMatrix4fv(shader->loc_projection_matrix, 1, GL_FALSE, glm::value_ptr(camera->projectionMatrix));
+			glUniform3fv(shader->loc_eye_pos, 1, glm::value_ptr(camera->position));
+
+			uniforms = &ShaderUniforms::Get(shader);
+			glUniform1i(uniforms->texture1, 0);
+			glUniform1f(uniforms->time, time);
+		}
+
+		glUniformMatrix4fv(shader->loc_model_matrix, 1, GL_FALSE, glm::value_ptr(packet.model));
+
+		// Bind Material Data
+		const Material& material = render.material;
+		glUniform3fv(uniforms->material.emmisive, 1, glm::value_ptr(material.emmisive));
+		glUniform3fv(uniforms->material.ambient, 1, glm::value_ptr(material.ambient));
+		glUniform3fv(uniforms->material.diffuse, 1, glm::value_ptr(material.diffuse));
+		glUniform3fv(uniforms->material.specular, 1, glm::value_ptr(material.specular));
+		glUniform1f(uniforms->material.shininess, material.shininess);
+
+		// Bind Texture Data
+		if (render.hasTexture && render.texture != currentTexture) {
+			currentTexture = render.texture;
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, currentTexture->GetTextureID());
+			stats.textureSwitches++;
+		}
+		glUniform1i(uniforms->has_texture, render.hasTexture);
+		glUniform1i(uniforms->is_distorted, (render.distortedTime > 0));
+
+		if (render.emissionMaps[0] != nullptr && render.emissionMaps[1] != nullptr)
+		{
+			glActiveTexture(GL_TEXTURE1);
+			glBindTexture(GL_TEXTURE_2D, render.emissionMaps[0]->GetTextureID());
+			glUniform1i(uniforms->window_map, 1);
+			glActiveTexture(GL_TEXTURE2);
+			glBindTexture(GL_TEXTURE_2D, render.emissionMaps[1]->GetTextureID());
+			glUniform1i(uniforms->exhaust_map, 2);
+			glActiveTexture(GL_TEXTURE0);
+			stats.textureSwitches += 2;
+
+			// Spaceship shader data
+			using namespace ObjectConstants;
+			glUniform3fv(uniforms->window_color_emm, 1, glm::value_ptr(window_color_emm));
+			glUniform3fv(uniforms->exhaust_color_emm, 1, glm::value_ptr(exhaust_color_emm));
+		}
+
+		GLuint vao = render.mesh->GetBuffers()->VAO;
+		if (vao != currentVAO) {
+			currentVAO = vao;
+			glBindVertexArray(vao);
+			stats.vaoSwitches++;
+		}
+
+		glDrawElements(render.mesh->GetDrawMode(), static_cast<int>(render.mesh->indices.size()), GL_UNSIGNED_SHORT, 0);
+		stats.drawCalls++;
+	}
+
+	packets.clear();
+	entries.clear();
+}
+
+void GameEngine::RenderQueue::SetSorting(const bool enabled)
+{
+	sorting = enabled;
+}
+
+bool GameEngine::RenderQueue::IsSorting() const
+{
+	return sorting;
+}
\ No newline at end of file
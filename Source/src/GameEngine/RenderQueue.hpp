@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <Core/Engine.h>
+#include "Camera.hpp"
+#include "Components.hpp"
+
+namespace GameEngine {
+	/// <summary>
+	/// The render passes, in the order they are drawn
+	/// </summary>
+	enum class RenderPass : unsigned char { Opaque, Transparent };
+
+	/// <summary>
+	/// The number of state changes made while rendering a frame, how many objects were culled,
+	/// and the time spent preparing and submitting the draws
+	/// </summary>
+	struct RenderStats {
+		unsigned int programSwitches = 0;
+		unsigned int textureSwitches = 0;
+		unsigned int vaoSwitches = 0;
+		unsigned int drawCalls = 0;
+		unsigned int visibleObjects = 0;
+		unsigned int culledObjects = 0;
+		double recordTime = 0;		// The CPU time used to prepare the draws (on the worker threads), in ms
+		double submitTime = 0;		// The CPU time used by the OpenGL thread to submit them, in ms
+	};
+
+	/// <summary>
+	/// The draw of an object, with everything needed to sort and render it. Creating it doesn't
+	/// use OpenGL, so the commands can be recorded on any thread (see CommandBuffer).
+	/// </summary>
+	struct DrawCommand {
+		uint64_t key;
+		glm::mat4 model;
+		const RenderComponent* render;	// It must be valid until the command is rendered
+	};
+
+	/// <summary>
+	/// Collects the draw packets of a frame and renders them sorted by a 64-bit key, so the
+	/// objects that use the same shader, texture and mesh are drawn one after another.
+	/// The key is made of (from the most significant bits):
+	/// pass (2 bits) | shader (12 bits) | texture (12 bits) | mesh (12 bits) | depth (24 bits).
+	/// The packets are sorted with a radix sort and the binds of the program, texture and
+	/// VAO are skipped when they don't change from the previous packet. The ids of the resources
+	/// are their OpenGL names, so the keys can be computed on any thread.
+	/// </summary>
+	class RenderQueue {
+	public:
+		/// <summary>
+		/// The depth range stored in the key (objects further away share the maximum depth)
+		/// </summary>
+		static constexpr float maxDepth = 256.f;
+
+		RenderQueue();
+
+		/// <summary>
+		/// Add an object to the queue
+		/// </summary>
+		/// <param name="pass">The pass the object is rendered in</param>
+		/// <param name="transform">The transform of the object</param>
+		/// <param name="render">The render data of the object (it must be valid until Flush)</param>
+		/// <param name="camera">The camera, used to compute the depth of the object</param>
+		void Submit(const RenderPass pass, const TransformComponent& transform, const RenderComponent& render, Camera* camera);
+
+		/// <summary>
+		/// Add a recorded draw command to the queue
+		/// </summary>
+		/// <param name="command">The command</param>
+		void Submit(const DrawCommand& command);
+
+		/// <summary>
+		/// Create the draw command of an object (without any OpenGL call)
+		/// </summary>
+		/// <param name="pass">The pass the object is rendered in</param>
+		/// <param name="transform">The transform of the object</param>
+		/// <param name="render">The render data of the object</param>
+		/// <param name="eyePosition">The position of the camera</param>
+		/// <param name="viewDirection">The direction the camera looks at</param>
+		/// <param name="command">The command</param>
+		/// <returns>False if the object is not rendered</returns>
+		static bool Record(const RenderPass pass, const TransformComponent& transform, const RenderComponent& render,
+			const glm::vec3& eyePosition, const glm::vec3& viewDirection, DrawCommand& command);
+
+		/// <summary>
+		/// Render all the queued packets and clear the queue
+		/// </summary>
+		/// <param name="camera">The camera</param>
+		/// <param name="stats">The stats where the state changes are added</param>
+		void Flush(Camera* camera, RenderStats& stats);
+
+		/// <summary>
+		/// Enable or disable the sorting (used to measure the state changes it saves)
+		/// </summary>
+		void SetSorting(const bool enabled);
+		bool IsSorting() const;
+
+	private:
+		struct SortEntry {
+			uint64_t key;
+			uint32_t index;
+		};
+
+		std::vector<DrawCommand> packets;
+		std::vector<SortEntry> entries, scratch;
+		bool sorting;
+
+		/// <summary>
+		/// Get the id of a resource, from its OpenGL name. The ids are limited to 12 bits, the
+		/// extra resources share the last id (they are still drawn correctly, only not grouped).
+		/// </summary>
+		static uint64_t ResourceId(const GLuint name);
+
+		/// <summary>
+		/// Sort the entries by their key (LSD radix sort, 8 bits per pass)
+		/// </summary>
+		void RadixSort();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#include "ShaderUniforms.hpp"
+
+#include <unordered_map>
+
+const GameEngine::ShaderUniforms& GameEngine::ShaderUniforms::Get(Shader* shader)
+{
+	// Indexed by the shader, not by the program: a reloaded shader usually gets the name of its
+	// deleted program back, with different locations
+	static std::unordered_map<const Shader*, ShaderUniforms> tables;
+
+	auto it = tables.find(shader);
+	if (it == tables.end()) {
+		it = tables.emplace(shader, ShaderUniforms()).first;
+		ShaderUniforms* table = &it->second;	// The elements of the map don't move
+		table->Load(shader);
+		shader->OnLoad([table, shader] { table->Load(shader); });
+	}
+	return it->second;
+}
+
+void GameEngine::ShaderUniforms::Load(const Shader* shader)
+{
+	material.emmisive = shader->GetCachedUniformLocation("material.emmisive");
+	material.ambient = shader->GetCachedUniformLocation("material.ambient");
+	material.diffuse = shader->GetCachedUniformLocation("material.diffuse");
+	material.specular = shader->GetCachedUniformLocation("material.specular");
+	material.shininess = shader->GetCachedUniformLocation("material.shininess");
+
+	texture1 = shader->GetCachedUniformLocation("texture1");
+	has_texture = shader->GetCachedUniformLocation("has_texture");
+	time = shader->GetCachedUniformLocation("time");
+	is_distorted = shader->GetCachedUniformLocation("is_distorted");
+	object_color = shader->GetCachedUniformLocation("object_color");
+
+	window_map = shader->GetCachedUniformLocation("window_map");
+	exhaust_map = shader->GetCachedUniformLocation("exhaust_map");
+	window_color_emm = shader->GetCachedUniformLocation("window_color_emm");
+	exhaust_color_emm = shader->GetCachedUniformLocation("exhaust_color_emm");
+}
\ No newline at end of file
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <Core/Engine.h>
+
+namespace GameEngine {
+	namespace ShaderConstants {
+		// Must match "max_light_sources" in the shaders
+		const int maxLightSources = 64;
+	}
+
+	/// <summary>
+	/// The locations of the uniforms used to render the game objects, for one shader program
+	/// (the lights are not part of it, they are in the shared LightBuffer).
+	/// The table is built when a shader is first used (from its uniform reflection cache), and
+	/// rebuilt every time the shader is linked again, so the renderer never builds uniform names
+	/// or asks the driver for locations.
+	/// A location is -1 if the program doesn't use that uniform.
+	/// </summary>
+	struct ShaderUniforms {
+		struct MaterialUniforms {
+			GLint emmisive, ambient, diffuse, specular, shininess;
+		};
+
+		MaterialUniforms material;
+
+		GLint texture1;
+		GLint has_texture;
+		GLint time;
+		GLint is_distorted;
+		GLint object_color;
+
+		// Spaceship shader
+		GLint window_map;
+		GLint exhaust_map;
+		GLint window_color_emm;
+		GLint exhaust_color_emm;
+
+		/// <summary>
+		/// Get the uniform table of a shader. It is created the first time the shader is used.
+		/// </summary>
+		/// <param name="shader">The shader (it must exist until the end of the game)</param>
+		/// <returns>The uniform table</returns>
+		static const ShaderUniforms& Get(Shader* shader);
+
+	private:
+		/// <summary>
+		/// Build the uniform table of a shader
+		/// </summary>
+		/// <param name="shader">The shader</param>
+		void Load(const Shader* shader);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,45 @@
+#include "SpawnPool.hpp"
+
+size_t GameEngine::SpawnPool::Key(const ObjectType type)
+{
+	return (size_t)type.category * maxVariants + type.variant;
+}
+
+void GameEngine::SpawnPool::Init(const std::vector<ObjectType>& archetypes)
+{
+	prototypes.clear();
+	created.clear();
+
+	for (auto& type : archetypes) {
+		size_t key = Key(type);
+		if (key >= prototypes.size()) {
+			prototypes.resize(key + 1);
+			created.resize(key + 1, false);
+		}
+
+		// The prototypes are built at the origin, and moved when they are spawned
+		prototypes[key] = GameObject(type, glm::vec3(0));
+		created[key] = true;
+	}
+}
+
+GameEngine::EntityHandle GameEngine::SpawnPool::Spawn(EntityStore& entities, const ObjectType type, const glm::vec3& position) const
+{
+	size_t key = Key(type);
+	if (key >= prototypes.size() || !created[key]) {
+		// Not an archetype, build the object (slower, but still valid)
+		return entities.Create(GameObject(type, position));
+	}
+
+	const GameObject& prototype = prototypes[key];
+	EntityHandle handle = entities.Create(prototype);
+
+	// The height of a platform is computed by its constructor, from the height of its top
+	glm::vec3 placed = position;
+	if (type.is(ObjectCategory::Platform)) {
+		placed.y = prototype.getPosition().y;
+	}
+	entities.Place(entities.IndexOf(handle), placed);
+
+	return handle;
+}
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include "EntityStore.hpp"
+
+namespace GameEngine {
+	/// <summary>
+	/// Spawns the objects that are created and removed all the time (platforms, obstacles,
+	/// planets and stars). A prototype of every archetype (type and variant) is built once, with
+	/// its resources already resolved. Spawning copies the components of the prototype in a free
+	/// slot of the EntityStore (the slots of the removed objects are reused), so no game object
+	/// is constructed and no memory is allocated while the game runs.
+	/// </summary>
+	class SpawnPool {
+	public:
+		/// <summary>
+		/// The number of variants an archetype can have (enough for all the platform colors)
+		/// </summary>
+		static const unsigned int maxVariants = 8;
+
+		/// <summary>
+		/// Build the prototypes of the archetypes. The resources used by the game objects must be set.
+		/// </summary>
+		/// <param name="archetypes">The types that will be spawned</param>
+		void Init(const std::vector<ObjectType>& archetypes);
+
+		/// <summary>
+		/// Create an entity from the prototype of its archetype
+		/// </summary>
+		/// <param name="entities">The store where the entity is created</param>
+		/// <param name="type">The type of the object (it must be one of the archetypes)</param>
+		/// <param name="position">The position of the object (platforms keep the height of their prototype)</param>
+		/// <returns>The handle of the new entity</returns>
+		EntityHandle Spawn(EntityStore& entities, const ObjectType type, const glm::vec3& position) const;
+
+	private:
+		std::vector<GameObject> prototypes;		// Indexed by category * maxVariants + variant
+		std::vector<bool> created;
+
+		static size_t Key(const ObjectType type);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "SpriteBatch.hpp"
+
+#include <cstddef>
+#include <algorithm>
+
+GameEngine::SpriteBatch::SpriteBatch() : shader(nullptr), vao(0), vbo(0), ibo(0), capacity(0), drawCalls(0) {}
+
+GameEngine::SpriteBatch::~SpriteBatch()
+{
+	if (vao != 0) {
+		glDeleteBuffers(1, &vbo);
+		glDeleteBuffers(1, &ibo);
+		glDeleteVertexArrays(1, &vao);
+	}
+}
+
+void GameEngine::SpriteBatch::Init(Shader* shader, const unsigned int capacity)
+{
+	this->shader = shader;
+
+	// The indices are unsigned shorts, so a batch can have at most 16384 quads
+	this->capacity = std::min(capacity, 16384u);
+	vertices.reserve(this->capacity * 4);
+	textures.reserve(maxTextures);
+
+	glGenVertexArrays(1, &vao);
+	glBindVertexArray(vao);
+
+	// The vertices are rewritten every frame
+	glGenBuffers(1, &vbo);
+	glBindBuffer(GL_ARRAY_BUFFER, vbo);
+	glBufferData(GL_ARRAY_BUFFER, this->capacity * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+
+	glEnableVertexAttribArray(0);
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, position));
+	glEnableVertexAttribArray(1);
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoord));
+	glEnableVertexAttribArray(2);
+	glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, color));
+	glEnableVertexAttribArray(3);
+	glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, textureSlot));
+
+	// The indices are the same for every batch (two triangles per quad)
+	std::vector<unsigned short> indices(this->capacity * 6);
+	for (unsigned int i = 0; i < this->capacity; ++i) {
+		unsigned short first = (unsigned short)(i * 4);
+		indices[i * 6 + 0] = first;
+		indices[i * 6 + 1] = first + 1;
+		indices[i * 6 + 2] = first + 2;
+		indices[i * 6 + 3] = first;
+		indices[i * 6 + 4] = first + 2;
+		indices[i * 6 + 5] = first + 3;
+	}
+
+	glGenBuffers(1, &ibo);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ibo);
+	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned short), indices.data(), GL_STATIC_DRAW);
+
+	glBindVertexArray(0);
+}
+
+unsigned int GameEngine::SpriteBatch::Add(const Sprite& sprite)
+{
+	sprites.push_back(sprite);
+	return (unsigned int)sprites.size() - 1;
+}
+
+GameEngine::Sprite& GameEngine::SpriteBatch::Get(const unsigned int id)
+{
+	return sprites[id];
+}
+
+unsigned int GameEngine::SpriteBatch::DrawCalls() const
+{
+	return drawCalls;
+}
+
+int GameEngine::SpriteBatch::TextureSlot(Texture2D* texture)
+{
+	for (size_t i = 0; i < textures.size(); ++i) {
+		if (textures[i] == texture) return (int)i;
+	}
+
+	if (textures.size() == maxTextures) return -1;
+	textures.push_back(texture);
+	return (int)textures.size() - 1;
+}
+
+void GameEngine::SpriteBatch::Render()
+{
+	drawCalls = 0;
+	if (vao == 0 || shader == nullptr) return;
+
+	// The sprites are drawn in order, over everything else
+	GLboolean depthTest = glIsEnabled(GL_DEPTH_TEST);
+	glDisable(GL_DEPTH_TEST);
+	glUseProgram(shader->program);
+	glBindVertexArray(vao);
+
+	for (auto& sprite : sprites) {
+		if (!sprite.visible) continue;
+
+		float slot = -1;
+		if (sprite.texture != nullptr) {
+			int textureSlot = TextureSlot(sprite.texture);
+			if (textureSlot == -1) {
+				Flush();
+				textureSlot = TextureSlot(sprite.texture);
+			}
+			slot = (float)textureSlot;
+		}
+
+		// The first row of the image is at the top of the quad
+		glm::vec2 half = sprite.size / 2.f;
+		vertices.push_back({ sprite.position + glm::vec2(-half.x, -half.y), glm::vec2(0, 1), sprite.color, slot });
+		vertices.push_back({ sprite.position + glm::vec2(half.x, -half.y), glm::vec2(1, 1), sprite.color, slot });
+		vertices.push_back({ sprite.position + glm::vec2(half.x, half.y), glm::vec2(1, 0), sprite.color, slot });
+		vertices.push_back({ sprite.position + glm::vec2(-half.x, half.y), glm::vec2(0, 0), sprite.color, slot });
+
+		if (vertices.size() == capacity * 4) {
+			Flush();
+		}
+	}
+	Flush();
+
+	glBindVertexArray(0);
+	if (depthTest) glEnable(GL_DEPTH_TEST);
+}
+
+void GameEngine::SpriteBatch::Flush()
+{
+	if (!vertices.empty()) {
+		for (size_t i = 0; i < textures.size(); ++i) {
+			textures[i]->BindToTextureUnit(GL_TEXTURE0 + (GLenum)i);
+		}
+
+		// Orphan the buffer, so the driver doesn't wait for the previous draw call
+		glBindBuffer(GL_ARRAY_BUFFER, vbo);
+		glBufferData(GL_ARRAY_BUFFER, capacity * 4 * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, vertices.size() * sizeof(Vertex), vertices.data());
+
+		glDrawElements(GL_TRIANGLES, (GLsizei)(vertices.size() / 4 * 6), GL_UNSIGNED_SHORT, 0);
+		drawCalls++;
+	}
+
+	vertices.clear();
+	textures.clear();
+}
\ No newline at end of file
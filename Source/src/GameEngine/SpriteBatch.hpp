@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+
+#include <Core/Engine.h>
+
+namespace GameEngine {
+	/// <summary>
+	/// A 2D quad of the HUD, in normalized device coordinates
+	/// </summary>
+	struct Sprite {
+		glm::vec2 position = glm::vec2(0);	// The center of the quad
+		glm::vec2 size = glm::vec2(0);
+		glm::vec3 color = glm::vec3(1);		// Used when there is no texture
+		Texture2D* texture = nullptr;
+		bool visible = true;
+	};
+
+	/// <summary>
+	/// Draws the HUD (the fuel bar, the lives, the score, the debug overlays) as a batch of quads.
+	/// The sprites are created once and kept between frames - every frame, only their properties
+	/// are changed. The quads of the visible sprites are written in a streaming vertex buffer
+	/// and drawn with a single call, in the order the sprites were added. Up to maxTextures
+	/// different textures can be used in a batch; if there are more, the batch is split.
+	/// </summary>
+	class SpriteBatch {
+	public:
+		/// <summary>
+		/// The number of textures that can be used by a single draw call
+		/// </summary>
+		static const unsigned int maxTextures = 4;
+
+		SpriteBatch();
+		~SpriteBatch();
+
+		/// <summary>
+		/// Create the buffers. Must be called from the thread with the OpenGL context.
+		/// </summary>
+		/// <param name="shader">The shader used to draw the sprites (UI)</param>
+		/// <param name="capacity">The maximum number of quads drawn by a single call</param>
+		void Init(Shader* shader, const unsigned int capacity);
+
+		/// <summary>
+		/// Add a sprite. It is drawn every frame, until it is hidden.
+		/// </summary>
+		/// <param name="sprite">The sprite</param>
+		/// <returns>The id of the sprite</returns>
+		unsigned int Add(const Sprite& sprite);
+
+		/// <summary>
+		/// Get a sprite, to change it
+		/// </summary>
+		/// <param name="id">The id of the sprite</param>
+		/// <returns>The sprite</returns>
+		Sprite& Get(const unsigned int id);
+
+		/// <summary>
+		/// Draw all the visible sprites
+		/// </summary>
+		void Render();
+
+		/// <summary>
+		/// Get the number of draw calls used by the last Render
+		/// </summary>
+		unsigned int DrawCalls() const;
+
+	private:
+		struct Vertex {
+			glm::vec2 position;
+			glm::vec2 texCoord;
+			glm::vec3 color;
+			float textureSlot;	// -1 if the quad is not textured
+		};
+
+		Shader* shader;
+		GLuint vao, vbo, ibo;
+		unsigned int capacity;
+
+		std::vector<Sprite> sprites;
+		std::vector<Vertex> vertices;		// The quads of the current batch
+		std::vector<Texture2D*> textures;	// The textures of the current batch, by slot
+		unsigned int drawCalls;
+
+		/// <summary>
+		/// Get the slot of a texture in the current batch, adding it if needed
+		/// </summary>
+		/// <returns>The slot, or -1 if all the slots are used</returns>
+		int TextureSlot(Texture2D* texture);
+
+		/// <summary>
+		/// Upload and draw the current batch, then clear it
+		/// </summary>
+		void Flush();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace GameEngine {
+	/// <summary>
+	/// A fixed size, lock-free queue between two threads: one thread only pushes (the producer)
+	/// and the other one only pops (the consumer). The items are stored in a ring buffer, so the
+	/// queue never allocates memory. The two indices are kept on separate cache lines, so the
+	/// threads don't slow each other down when they update them.
+	/// </summary>
+	/// <typeparam name="T">The type of the items (copied in and out of the queue)</typeparam>
+	/// <typeparam name="Capacity">The maximum number of items (a power of two)</typeparam>
+	template <typename T, size_t Capacity>
+	class SpscQueue {
+		static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "The capacity of the queue must be a power of two");
+
+	public:
+		SpscQueue() : head(0), tail(0) {}
+
+		/// <summary>
+		/// Add an item at the end of the queue. Only called by the producer.
+		/// </summary>
+		/// <param name="item">The item</param>
+		/// <returns>False if the queue is full</returns>
+		bool TryPush(const T& item) {
+			size_t last = tail.load(std::memory_order_relaxed);
+			if (last - head.load(std::memory_order_acquire) == Capacity) return false;
+
+			items[last & (Capacity - 1)] = item;
+			tail.store(last + 1, std::memory_order_release);
+			return true;
+		}
+
+		/// <summary>
+		/// Remove the item at the front of the queue. Only called by the consumer.
+		/// </summary>
+		/// <param name="item">Where the item is copied</param>
+		/// <returns>False if the queue is empty</returns>
+		bool TryPop(T& item) {
+			size_t first = head.load(std::memory_order_relaxed);
+			if (first == tail.load(std::memory_order_acquire)) return false;
+
+			item = items[first & (Capacity - 1)];
+			head.store(first + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool Full() const {
+			return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) == Capacity;
+		}
+
+		bool Empty() const {
+			return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+		}
+
+	private:
+		static const size_t cacheLine = 64;
+
+		std::atomic<size_t> head;		// The next item to pop, written by the consumer
+		char headPadding[cacheLine - sizeof(std::atomic<size_t>)];
+		std::atomic<size_t> tail;		// The next free slot, written by the producer
+		char tailPadding[cacheLine - sizeof(std::atomic<size_t>)];
+		T items[Capacity];
+	};
+}
\ No newline at end of file
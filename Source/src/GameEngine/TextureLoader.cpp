@@ -0,0 +1,142 @@
+#include "TextureLoader.hpp"
+
+#include <cstring>
+#include <algorithm>
+#include <stb/stb_image.h>
+
+GameEngine::TextureLoader::TextureLoader(unsigned int threadCount) : pending(0), stopping(false), pixelBuffers(), nextPixelBuffer(0)
+{
+	if (threadCount == 0) {
+		threadCount = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	for (unsigned int i = 0; i < threadCount; ++i) {
+		workers.push_back(std::thread(&TextureLoader::Work, this));
+	}
+}
+
+GameEngine::TextureLoader::~TextureLoader()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	requestAdded.notify_all();
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+
+	// Release the images that were never returned
+	for (auto& image : results) {
+		Free(image);
+	}
+
+	if (pixelBuffers[0] != 0) {
+		glDeleteBuffers(pixelBufferCount, pixelBuffers);
+	}
+}
+
+void GameEngine::TextureLoader::Add(const std::string& name, const std::string& path)
+{
+	Image image = {};
+	image.name = name;
+	image.path = path;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		requests.push_back(image);
+		pending++;
+	}
+	requestAdded.notify_one();
+}
+
+void GameEngine::TextureLoader::Work()
+{
+	while (true) {
+		Image image;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			requestAdded.wait(lock, [this] { return stopping || !requests.empty(); });
+			if (requests.empty()) return;
+
+			image = requests.front();
+			requests.pop_front();
+		}
+
+		// Decode outside of the lock
+		image.data = stbi_load(image.path.c_str(), &image.width, &image.height, &image.channels, 0);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			results.push_back(image);
+		}
+		resultAdded.notify_one();
+	}
+}
+
+bool GameEngine::TextureLoader::Next(Image& image)
+{
+	std::unique_lock<std::mutex> lock(mutex);
+	if (pending == 0) return false;
+
+	resultAdded.wait(lock, [this] { return !results.empty(); });
+	image = results.front();
+	results.pop_front();
+	pending--;
+
+	return true;
+}
+
+Texture2D* GameEngine::TextureLoader::Upload(const Image& image, const GLenum wrappingMode)
+{
+	if (image.data == nullptr) return nullptr;
+
+	if (pixelBuffers[0] == 0) {
+		glGenBuffers(pixelBufferCount, pixelBuffers);
+	}
+
+	// Copy the pixels in the next pixel buffer. The storage is orphaned first, so the
+	// copy doesn't wait for the transfer of a previous image that used the same buffer.
+	GLsizeiptr size = (GLsizeiptr)image.width * image.height * image.channels;
+	glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pixelBuffers[nextPixelBuffer]);
+	glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+
+	void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+	if (mapped != nullptr) {
+		memcpy(mapped, image.data, size);
+		glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+	}
+
+	// The rows of the images are tightly packed
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+
+	Texture2D* texture = new Texture2D();
+	if (mapped != nullptr) {
+		// The pixels are read from the bound pixel buffer (the pointer is an offset in it)
+		texture->Load2DFromMemory(nullptr, image.width, image.height, image.channels, wrappingMode);
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+	else {
+		glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+		texture->Load2DFromMemory(image.data, image.width, image.height, image.channels, wrappingMode);
+	}
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	nextPixelBuffer = (nextPixelBuffer + 1) % pixelBufferCount;
+
+	return texture;
+}
+
+void GameEngine::TextureLoader::Free(Image& image)
+{
+	if (image.data != nullptr) {
+		stbi_image_free(image.data);
+		image.data = nullptr;
+	}
+}
+
+unsigned int GameEngine::TextureLoader::ThreadCount() const
+{
+	return (unsigned int)workers.size();
+}
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include <Core/Engine.h>
+
+namespace GameEngine {
+	/// <summary>
+	/// Loads textures in parallel. The image files are decoded by a pool of worker threads,
+	/// and the main thread (the one with the OpenGL context) uploads every image as soon as it
+	/// is decoded, through pixel buffer objects, while the other images are still decoding.
+	/// </summary>
+	class TextureLoader {
+	public:
+		/// <summary>
+		/// A decoded image (data is null if the file couldn't be decoded)
+		/// </summary>
+		struct Image {
+			std::string name;
+			std::string path;
+			unsigned char* data;
+			int width, height, channels;
+		};
+
+		/// <summary>
+		/// The number of pixel buffers used for the uploads (one is filled while the other is transferred)
+		/// </summary>
+		static const unsigned int pixelBufferCount = 2;
+
+		/// <summary>
+		/// Start the worker threads
+		/// </summary>
+		/// <param name="threadCount">The number of workers (0 - one for every hardware thread)</param>
+		explicit TextureLoader(unsigned int threadCount = 0);
+		~TextureLoader();
+
+		/// <summary>
+		/// Add an image to be decoded
+		/// </summary>
+		/// <param name="name">The name of the texture</param>
+		/// <param name="path">The path of the image file</param>
+		void Add(const std::string& name, const std::string& path);
+
+		/// <summary>
+		/// Wait for the next decoded image (in the order they finish decoding)
+		/// </summary>
+		/// <param name="image">Where the image is stored. It must be released with Free.</param>
+		/// <returns>False if there are no more images to decode</returns>
+		bool Next(Image& image);
+
+		/// <summary>
+		/// Create a mipmapped texture from a decoded image, uploading it through a pixel buffer.
+		/// Must be called from the thread with the OpenGL context.
+		/// </summary>
+		/// <param name="image">The image</param>
+		/// <param name="wrappingMode">The wrapping mode of the texture</param>
+		/// <returns>The texture</returns>
+		Texture2D* Upload(const Image& image, const GLenum wrappingMode);
+
+		/// <summary>
+		/// Release the pixels of a decoded image
+		/// </summary>
+		static void Free(Image& image);
+
+		/// <summary>
+		/// Get the number of worker threads
+		/// </summary>
+		unsigned int ThreadCount() const;
+
+	private:
+		std::vector<std::thread> workers;
+		std::deque<Image> requests;		// Images that must be decoded (only the name and path are set)
+		std::deque<Image> results;		// Decoded images
+		size_t pending;					// Images added, but not yet returned by Next
+		bool stopping;
+
+		std::mutex mutex;
+		std::condition_variable requestAdded;
+		std::condition_variable resultAdded;
+
+		GLuint pixelBuffers[pixelBufferCount];
+		unsigned int nextPixelBuffer;
+
+		/// <summary>
+		/// The loop of a worker thread
+		/// </summary>
+		void Work();
+	};
+}
\ No newline at end of file
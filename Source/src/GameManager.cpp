@@ -2,49 +2,44 @@
 
 #include <vector>
 #include <queue>
-#include <math.h>
-
-/// <summary>
-/// Map a value that is in a range to another range
-/// </summary>
-/// <param name="sourceNumber">The value</param>
-/// <param name="fromA">Starting value of the first range</param>
-/// <param name="fromB">End value of the first range</param>
-/// <param name="toA">Starting value of the second range</param>
-/// <param name="toB">End value of the second range</param>
-/// <param name="decimalPrecision">The number of decimals to use</param>
-/// <returns>The mapped value</returns>
-double mapBetweenRanges(double sourceNumber, double fromA, double fromB, double toA, double toB, int decimalPrecision) {
-	double deltaA = fromB - fromA;
-	double deltaB = toB - toA;
-	double scale = deltaB / deltaA;
-	double negA = -1 * fromA;
-	double offset = (negA * scale) + toA;
-	double finalNumber = (sourceNumber * scale) + offset;
-	int calcScale = (int)pow(10, decimalPrecision);
-	return (double)round(finalNumber * calcScale) / calcScale;
-}
+#include <algorithm>
+#include <ctime>
 
 using namespace Skyroads;
 
-GameManager::GameManager()
+GameManager::GameManager() : jumpRequested(false), showRenderStats(false), renderStatsTimer(0), showGpuOverlay(false), gpuStatsTimer(0)
 {
 	camera = new GameEngine::Camera();
 	camera->Set(glm::vec3(0, 5.f, 30.f), glm::vec3(0, 1, 0), glm::vec3(0, 1, 0));
-	camera->distanceToTarget = gameState.cameraSettings.distanceToTarget;
-	camera->projectionMatrix = glm::perspective(RADIANS(gameState.cameraSettings.cameraFOV), window->props.aspectRatio, 0.01f, 200.f);
+	camera->distanceToTarget = cameraSettings.distanceToTarget;
+	camera->projectionMatrix = glm::perspective(RADIANS(cameraSettings.cameraFOV), window->props.aspectRatio, 0.01f, 200.f);
+
+	SetTickRate(Constants::tickRate);
+	simulation.SetJobSystem(&jobs);
 }
 
 GameManager::~GameManager()
 {
 }
 
+void GameManager::Record(const std::string& path)
+{
+	recordingPath = path;
+}
+
 void GameManager::Init()
 {
-	// Load meshes
+	// Load meshes and models
+	auto meshesStart = std::chrono::high_resolution_clock::now();
 	for each (auto & name in Constants::meshNames) {
 		LoadMesh(name, "Source/src/Meshes/");
 	}
+	for each (auto & name in Constants::modelNames) {
+		LoadMesh(name, "Source/src/Models/");
+	}
+	std::chrono::duration<double, std::milli> meshesDuration = std::chrono::high_resolution_clock::now() - meshesStart;
+	std::cout << "Loaded " << Constants::meshNames.size() + Constants::modelNames.size() << " meshes in " << meshesDuration.count() << " ms ("
+		<< (Constants::useBakedMeshes ? "baked" : "Assimp") << ")\n";
 
 	// Create a quad for the framebuffers
 	Mesh* mesh = GameEngine::CreateQuad();
@@ -57,20 +52,16 @@ void GameManager::Init()
 	meshes[mesh->GetMeshID()] = mesh;
 
 	// Load shaders
+	auto shadersStart = std::chrono::high_resolution_clock::now();
+	Shader::SetBinaryCache(Constants::useShaderCache ? "Source/src/Shaders/Cache" : "");
 	for each (auto & name in Constants::shaderNames) {
 		LoadShader(name, "Source/src/Shaders/");
 	}
+	std::chrono::duration<double, std::milli> shadersDuration = std::chrono::high_resolution_clock::now() - shadersStart;
+	std::cout << "Loaded " << Constants::shaderNames.size() << " shaders in " << shadersDuration.count() << " ms\n";
 
 	// Load textures
-	for each (auto & name in Constants::textureNames) {
-		LoadTexture(name, ".png", "Source/src/Textures/");
-	}
-	 
-	// Load models
-	for each (auto & name in Constants::modelNames) {
-		LoadTexture(name, ".png", "Source/src/Models/");
-		LoadMesh(name, "Source/src/Models/");
-	}
+	LoadTextures();
 
 	using namespace GameEngine;
 	// Link the meshes, shaders & textures to the game objects
@@ -78,23 +69,22 @@ void GameManager::Init()
 	GameObject::shaders = &shaders;
 	GameObject::textures = &textures;
 
-	// Initialize the player object
-	{
-		GameObject player("player", glm::vec3(Constants::playerStartingPosition));
-		player.getRigidBody().state.drag_coef = 10.f;
-		player.isInJump = true;
-		addGameObject(player);
+	// Initialize the game logic (and the player object)
+	unsigned int seed = (unsigned int)std::time(nullptr);
+	simulation.Init(seed);
+	if (!recordingPath.empty() && recorder.Open(recordingPath, seed, (float)GetFixedDeltaTime())) {
+		std::cout << "Recording the game in '" << recordingPath << "' (seed " << seed << ")\n";
 	}
 
 	// Initialize the skybox
 	{
-		skybox = GameObject("skybox", glm::vec3(Constants::playerStartingPosition));
+		skybox = GameObject(GameEngine::ObjectCategory::Skybox, glm::vec3(Constants::playerStartingPosition));
 	}
 
 	// Initialize permanent lights
 	{
 		// Update Light
-		glm::vec3 lightPosition = gameObjects[0].getRigidBody().state.x;
+		glm::vec3 lightPosition = simulation.getEntities().bodies[simulation.PlayerIndex()].state.x;
 
 		// Exhaust light
 		GameEngine::Light light = {
@@ -138,11 +128,74 @@ void GameManager::Init()
 	}
 
 	InitFramebuffers();
+	lightBuffer.Init();
+
+	// Platforms, obstacles and planets are drawn using instancing
+	instancedRenderer.Register(shaders["EmmisiveTransparency"], shaders["EmmisiveTransparencyInstanced"]);
+	instancedRenderer.Register(shaders["Planet"], shaders["PlanetInstanced"]);
+
+	InitHud();
+}
+
+void GameManager::InitHud()
+{
+	hud.Init(shaders["UI"], 256);
+
+	// The fuel bar, over its background
+	GameEngine::Sprite sprite;
+	sprite.position = glm::vec2(-0.9f, 0);
+	sprite.size = glm::vec2(Constants::fuelbarScale + Constants::fuelbarsDiff);
+	sprite.color = Constants::fuelbarBackgroundColor;
+	hud.Add(sprite);
+
+	sprite.size = glm::vec2(Constants::fuelbarScale);
+	sprite.color = Constants::fuelbarColor;
+	fuelbarSprite = hud.Add(sprite);
+
+	// The lives, from the bottom right corner upwards
+	sprite = GameEngine::Sprite();
+	sprite.size = glm::vec2(0.125f);
+	sprite.texture = textures["life"];
+	for (int i = 0; i < (int)Constants::maxLives; ++i) {
+		sprite.position = glm::vec2(0.9f, -0.9f + i * 0.15f);
+		lifeSprites.push_back(hud.Add(sprite));
+	}
+
+	// The score, in the top right corner. Every digit is made of 7 segments, in the order
+	// top, top right, bottom right, bottom, bottom left, top left, middle
+	const glm::vec2 digitSize = glm::vec2(0.04f, 0.1f);
+	const float thickness = 0.012f;
+	const glm::vec2 offsets[] = {
+		glm::vec2(0, 0.5f), glm::vec2(0.5f, 0.25f), glm::vec2(0.5f, -0.25f), glm::vec2(0, -0.5f),
+		glm::vec2(-0.5f, -0.25f), glm::vec2(-0.5f, 0.25f), glm::vec2(0)
+	};
+
+	sprite = GameEngine::Sprite();
+	sprite.color = Constants::scoreColor;
+	for (unsigned int digit = 0; digit < Constants::scoreDigits; ++digit) {
+		glm::vec2 center = glm::vec2(0.92f - digit * 0.065f, 0.88f);
+		for (int segment = 0; segment < 7; ++segment) {
+			bool horizontal = offsets[segment].x == 0;
+			sprite.position = center + offsets[segment] * digitSize;
+			sprite.size = horizontal ? glm::vec2(digitSize.x, thickness) : glm::vec2(thickness, digitSize.y / 2 + thickness / 2);
+			scoreSprites.push_back(hud.Add(sprite));
+		}
+	}
 }
 
 void GameManager::InitFramebuffers() {
 	glEnable(GL_MULTISAMPLE);
 
+	// Compute the size of the render targets
+	glm::ivec2 resolution = window->GetResolution();
+	renderResolution.x = std::max(1, (int)(resolution.x * renderSettings.renderScale));
+	renderResolution.y = std::max(1, (int)(resolution.y * renderSettings.renderScale));
+
+	// Use a sample count supported by the driver
+	GLint maxSamples = 1;
+	glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+	renderSettings.samples = glm::clamp(renderSettings.samples, 1u, (unsigned int)maxSamples);
+
 	// -- MSAA framebuffer configuration --
 	glGenFramebuffers(1, &msaa_framebuffer);
 	glBindFramebuffer(GL_FRAMEBUFFER, msaa_framebuffer);
@@ -151,7 +204,7 @@ void GameManager::InitFramebuffers() {
 	glGenTextures(2, msaa_colorbuffers);
 	for (uint i = 0; i < 2; ++i) {
 		glBindTexture(GL_TEXTURE_2D_MULTISAMPLE, msaa_colorbuffers[i]);
-		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, Constants::multisamples, GL_RGBA16F, 2560, 1440, GL_TRUE);
+		glTexImage2DMultisample(GL_TEXTURE_2D_MULTISAMPLE, renderSettings.samples, GL_RGBA16F, renderResolution.x, renderResolution.y, GL_TRUE);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -164,7 +217,7 @@ void GameManager::InitFramebuffers() {
 	// Create a renderbuffer object for depth and stencil attachment
 	glGenRenderbuffers(1, &msaa_renderbuffer);
 	glBindRenderbuffer(GL_RENDERBUFFER, msaa_renderbuffer);
-	glRenderbufferStorageMultisample(GL_RENDERBUFFER, Constants::multisamples, GL_DEPTH24_STENCIL8, 2560, 1440);
+	glRenderbufferStorageMultisample(GL_RENDERBUFFER, renderSettings.samples, GL_DEPTH24_STENCIL8, renderResolution.x, renderResolution.y);
 	glBindRenderbuffer(GL_RENDERBUFFER, 0);
 	glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, msaa_renderbuffer);
 
@@ -187,7 +240,7 @@ void GameManager::InitFramebuffers() {
 		glBindFramebuffer(GL_FRAMEBUFFER, pp_framebuffers[i]);
 
 		glBindTexture(GL_TEXTURE_2D, pp_colorbuffers[i]);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, 2560, 1440, 0, GL_RGBA, GL_FLOAT, NULL);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, renderResolution.x, renderResolution.y, 0, GL_RGBA, GL_FLOAT, NULL);
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
@@ -212,7 +265,7 @@ void GameManager::InitFramebuffers() {
 	glGenTextures(2, fx_colorbuffers);
 	for (uint i = 0; i < 2; ++i) {
 		glBindTexture(GL_TEXTURE_2D, fx_colorbuffers[i]);
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, 2560, 1440, 0, GL_RGBA, GL_FLOAT, NULL);
+		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, renderResolution.x, renderResolution.y, 0, GL_RGBA, GL_FLOAT, NULL);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -231,16 +284,30 @@ void GameManager::InitFramebuffers() {
 	}
 
 	// -- End Post-Processing framebuffer configuration --
+
+	bloom.Init(renderResolution);
 }
 
-void GameManager::addGameObject(GameEngine::GameObject object)
-{
-	gameObjects[object.getID()] = object;
+void GameManager::DeleteFramebuffers() {
+	glDeleteFramebuffers(1, &msaa_framebuffer);
+	glDeleteFramebuffers(1, &fx_framebuffer);
+	glDeleteFramebuffers(2, pp_framebuffers);
+	glDeleteTextures(2, msaa_colorbuffers);
+	glDeleteTextures(2, fx_colorbuffers);
+	glDeleteTextures(2, pp_colorbuffers);
+	glDeleteRenderbuffers(1, &msaa_renderbuffer);
+	bloom.Delete();
 }
 
-GameEngine::GameObject* GameManager::getGameObject(const long int id)
-{
-	return &(gameObjects[id]);
+void GameManager::ResizeFramebuffers() {
+	// Nothing to render into while the window is minimized
+	glm::ivec2 resolution = window->GetResolution();
+	if (resolution.x <= 0 || resolution.y <= 0) return;
+
+	DeleteFramebuffers();
+	InitFramebuffers();
+	std::cout << "Render targets: " << renderResolution.x << "x" << renderResolution.y
+		<< " (scale " << renderSettings.renderScale << ", " << renderSettings.samples << "x MSAA)\n";
 }
 
 void GameManager::LoadShader(std::string name, std::string shadersPath)
@@ -249,6 +316,7 @@ void GameManager::LoadShader(std::string name, std::string shadersPath)
 	shader->AddShader(shadersPath + name + ".VS.glsl", GL_VERTEX_SHADER);
 	shader->AddShader(shadersPath + name + ".FS.glsl", GL_FRAGMENT_SHADER);
 	shader->CreateAndLink();
+	GameEngine::LightBuffer::BindShader(shader);
 	shaders[shader->GetName()] = shader;
 }
 
@@ -261,237 +329,396 @@ void GameManager::LoadTexture(std::string name, std::string extension, std::stri
 	textures[name] = texture;
 }
 
+void GameManager::LoadTextures()
+{
+	auto start = std::chrono::high_resolution_clock::now();
+
+	// The textures of the game and of the models - (name, directory)
+	std::vector<std::pair<std::string, std::string>> files;
+	for each (auto & name in Constants::textureNames) {
+		files.push_back(std::make_pair(name, std::string("Source/src/Textures/")));
+	}
+	for each (auto & name in Constants::modelNames) {
+		files.push_back(std::make_pair(name, std::string("Source/src/Models/")));
+	}
+
+	// The baked (compressed) textures are used when they exist
+	bool compressed = Constants::useCompressedTextures && GameEngine::CompressedTexture::IsSupported();
+	size_t compressedCount = 0;
+
+	if (Constants::parallelTextureLoading) {
+		// The images are decoded by the worker threads, and uploaded here as soon as they are ready
+		GameEngine::TextureLoader loader;
+		for (auto& file : files) {
+			if (compressed && LoadCompressedTexture(file.first, file.second)) {
+				compressedCount++;
+				continue;
+			}
+			loader.Add(file.first, file.second + file.first + ".png");
+		}
+
+		GameEngine::TextureLoader::Image image;
+		while (loader.Next(image)) {
+			Texture2D* texture = loader.Upload(image, GL_REPEAT);
+			if (texture != nullptr) {
+				textures[image.name] = texture;
+			}
+			else {
+				std::cout << "ERROR::TEXTURE:: Couldn't load " << image.path << "\n";
+			}
+			GameEngine::TextureLoader::Free(image);
+		}
+	}
+	else {
+		for (auto& file : files) {
+			if (compressed && LoadCompressedTexture(file.first, file.second)) {
+				compressedCount++;
+				continue;
+			}
+			LoadTexture(file.first, ".png", file.second);
+		}
+	}
+
+	std::chrono::duration<double, std::milli> duration = std::chrono::high_resolution_clock::now() - start;
+	std::cout << "Loaded " << textures.size() << " textures (" << compressedCount << " compressed) in " << duration.count() << " ms ("
+		<< (Constants::parallelTextureLoading ? "parallel" : "sequential") << ")\n";
+}
+
+bool GameManager::LoadCompressedTexture(std::string name, std::string texturesPath)
+{
+	Texture2D* texture = GameEngine::CompressedTexture::Load(texturesPath + name + ".ktx", GL_REPEAT);
+	if (texture == nullptr) return false;
+
+	textures[name] = texture;
+	return true;
+}
+
 void GameManager::LoadMesh(std::string name, std::string meshesPath)
 {
-	Mesh* mesh = new Mesh(name.c_str());
-	mesh->LoadMesh(meshesPath, name + ".obj");
+	if (!Constants::useBakedMeshes) {
+		Mesh* mesh = new Mesh(name.c_str());
+		mesh->LoadMesh(meshesPath, name + ".obj");
+		meshes[mesh->GetMeshID()] = mesh;
+		return;
+	}
+
+	// Use the baked file, or (re)create it if it doesn't match the model. If it can't be
+	// created, the model is imported with Assimp.
+	GameEngine::BakedMesh* mesh = new GameEngine::BakedMesh(name.c_str());
+	std::string source = name + ".obj", baked = name + ".mesh";
+	if (!mesh->LoadBaked(meshesPath, source, baked)) {
+		if (!GameEngine::BakedMesh::Bake(meshesPath, source, baked) || !mesh->LoadBaked(meshesPath, source, baked)) {
+			mesh->LoadMesh(meshesPath, source);
+		}
+	}
 	meshes[mesh->GetMeshID()] = mesh;
 }
 
 void GameManager::FrameStart()
 {
+	gpuProfiler.BeginFrame();
+
 	// Bind to framebuffer
 	glBindFramebuffer(GL_FRAMEBUFFER, msaa_framebuffer);
 	glClearColor(0, 0, 0, 1);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	glEnable(GL_DEPTH_TEST);
 
-	glViewport(0, 0, 2560, 1440);
+	glViewport(0, 0, renderResolution.x, renderResolution.y);
 }
 
 void GameManager::UpdateCamera() {
-	camera->distanceToTarget = gameState.cameraSettings.distanceToTarget;
+	GameEngine::EntityStore& entities = simulation.getEntities();
+	size_t playerIndex = simulation.PlayerIndex();
+	glm::vec3 playerPosition = InterpolatedPosition(playerIndex);
+	camera->distanceToTarget = cameraSettings.distanceToTarget;
 
 	// Update camera mode and position
-	if (gameState.cameraSettings.cameraMode) {
+	if (cameraSettings.cameraMode) {
 		// 3rd Person
-		camera->Set(gameObjects[0].getRigidBody().state.x + glm::vec3(0.f, .5f, camera->distanceToTarget), gameObjects[0].getRigidBody().state.x - glm::vec3(0, 1, 100), glm::vec3(0, 1, 0));
-		gameObjects[0].isRendered(true);
-		camera->RotateThirdPerson_OX(gameState.cameraSettings.cameraRotation.x);
-		camera->RotateThirdPerson_OY(gameState.cameraSettings.cameraRotation.y);
+		camera->Set(playerPosition + glm::vec3(0.f, .5f, camera->distanceToTarget), playerPosition - glm::vec3(0, 1, 100), glm::vec3(0, 1, 0));
+		entities.renders[playerIndex].isRendered = true;
+		camera->RotateThirdPerson_OX(cameraSettings.cameraRotation.x);
+		camera->RotateThirdPerson_OY(cameraSettings.cameraRotation.y);
 	}
 	else {
 		// 1st Person
-		camera->Set(gameObjects[0].getRigidBody().state.x, gameObjects[0].getRigidBody().state.x - glm::vec3(0, 1, 100), glm::vec3(0, 1, 0));
-		gameObjects[0].isRendered(false);
-		camera->RotateFirstPerson_OX(gameState.cameraSettings.cameraRotation.x);
-		camera->RotateFirstPerson_OY(gameState.cameraSettings.cameraRotation.y);
+		camera->Set(playerPosition, playerPosition - glm::vec3(0, 1, 100), glm::vec3(0, 1, 0));
+		entities.renders[playerIndex].isRendered = false;
+		camera->RotateFirstPerson_OX(cameraSettings.cameraRotation.x);
+		camera->RotateFirstPerson_OY(cameraSettings.cameraRotation.y);
 	}
 
 	// Map the camera FOV to the player speed
-	gameState.cameraSettings.cameraFOV = (float)mapBetweenRanges(gameState.playerState.playerSpeed, Constants::minSpeed, Constants::maxSpeed, Constants::minFov, Constants::maxFov, 1);
+	cameraSettings.cameraFOV = (float)mapBetweenRanges(simulation.getGameState().playerState.playerSpeed, Constants::minSpeed, Constants::maxSpeed, Constants::minFov, Constants::maxFov, 1);
 
 	// Update the projection matrix
-	camera->projectionMatrix = glm::perspective(RADIANS(gameState.cameraSettings.cameraFOV), window->props.aspectRatio, 0.01f, 200.f);
+	camera->projectionMatrix = glm::perspective(RADIANS(cameraSettings.cameraFOV), window->props.aspectRatio, 0.01f, 200.f);
 }
 
-void GameManager::UpdatePlayer()
+void Skyroads::GameManager::RenderUI()
 {
-	float pSpeed = gameState.playerState.playerSpeed;
+	const GameState& gameState = simulation.getGameState();
 
-	// Move the player forward
-	gameObjects[0].getRigidBody().state.x.z -= gameState.playerState.playerSpeed;
+	// The fuel bar shrinks towards its center
+	float percent = gameState.playerState.fuel / Constants::maxFuel;
+	hud.Get(fuelbarSprite).size.y = Constants::fuelbarScale.y * percent;
 
-	if (window->KeyHold(GLFW_KEY_A)) {
-		// Move player left
-		gameObjects[0].getRigidBody().addImpulse(-Constants::lateralSpeed, 0, 0);
-	}
-	else if (window->KeyHold(GLFW_KEY_D)) {
-		// Move player right
-		gameObjects[0].getRigidBody().addImpulse(Constants::lateralSpeed, 0, 0);
+	for (size_t i = 0; i < lifeSprites.size(); ++i) {
+		hud.Get(lifeSprites[i]).visible = (float)i < gameState.playerState.lives;
 	}
-	else if (window->KeyHold(GLFW_KEY_W)) {
-		if (!gameState.playerState.isFullSpeed) {
-			// Speed up
-			pSpeed += Constants::speedStep;
-			if (pSpeed > Constants::maxSpeed) {
-				pSpeed = Constants::maxSpeed;
-			}
-		}
-	}
-	else if (window->KeyHold(GLFW_KEY_S)) {
-		if (!gameState.playerState.isFullSpeed) {
-			// Slow down
-			pSpeed -= Constants::speedStep;
-			if (pSpeed < Constants::minSpeed) {
-				pSpeed = Constants::minSpeed;
-			}
+
+	// The segments used by every digit, the first one being the top segment
+	static const unsigned char digitSegments[] = { 0x3F, 0x06, 0x5B, 0x4F, 0x66, 0x6D, 0x7D, 0x07, 0x7F, 0x6F };
+
+	// The digits are stored from the last one, the leading zeros are hidden
+	int score = glm::clamp(simulation.getScore(), 0, 999999);
+	for (unsigned int digit = 0; digit < Constants::scoreDigits; ++digit) {
+		bool shown = digit == 0 || score > 0;
+		unsigned char segments = digitSegments[score % 10];
+		for (int segment = 0; segment < 7; ++segment) {
+			hud.Get(scoreSprites[digit * 7 + segment]).visible = shown && (segments & (1 << segment)) != 0;
 		}
+		score /= 10;
 	}
 
-	// Check if the player has fallen
-	if (gameObjects[0].getPosition().y < Constants::outOfBoundY) {
+	hud.Render();
+}
+
+void GameManager::FixedUpdate(float fixedDeltaTimeSeconds)
+{
+	// Update the game logic
+	TickInput input;
+	if (window->KeyHold(GLFW_KEY_A)) input.keys |= InputKeys::Left;
+	if (window->KeyHold(GLFW_KEY_D)) input.keys |= InputKeys::Right;
+	if (window->KeyHold(GLFW_KEY_W)) input.keys |= InputKeys::Faster;
+	if (window->KeyHold(GLFW_KEY_S)) input.keys |= InputKeys::Slower;
+	if (jumpRequested) input.keys |= InputKeys::Jump;
+	jumpRequested = false;
+
+	recorder.Record(input);
+	simulation.Tick(input, fixedDeltaTimeSeconds);
+	if (simulation.isGameOver()) {
 		GameOver();
 	}
+}
 
-	gameState.playerState.playerSpeed = pSpeed;
+glm::vec3 GameManager::InterpolatedPosition(const size_t index)
+{
+	const GameEngine::TransformComponent& transform = simulation.getEntities().transforms[index];
+	return glm::mix(transform.previousPosition, transform.position, GetInterpolationAlpha());
 }
 
-void GameManager::UpdateGameState(const float deltaTime)
+void GameManager::Update(float deltaTimeSeconds)
 {
-	// Update Player
-	UpdatePlayer();
+	GameEngine::EntityStore& entities = simulation.getEntities();
+
+	// Render skybox
+	gpuProfiler.Begin("Skybox");
+	RenderSkybox();
+	gpuProfiler.End();
 
 	// Update camera
 	UpdateCamera();
 
-	// Compute the current score
-	ComputeScore();
-	
-	// Update the platforms
-	PlatformManagement();
-
-	// Update the decorations
-	DecorationManagement();
-
-	// Check fuel state
-	float speedFuelFactor = mapBetweenRanges(gameState.playerState.playerSpeed, Constants::minSpeed, Constants::maxSpeed, 0.5, 1.5, 1);
-	gameState.playerState.fuel -= deltaTime * Constants::fuelFlow * speedFuelFactor;
-	if (gameState.playerState.fuel <= 0) {
-		// If all the fuel was used, a life is lost. If the game can go on
-		// (at least 1 life remaining), reset the fuel to max
-
-		gameState.playerState.lives--;
-		if (gameState.playerState.lives > 0) {
-			gameState.playerState.fuel = Constants::maxFuel;
-		}
-	}
+	// Update the lights attached to the player
+	glm::vec3 lightPosition = InterpolatedPosition(simulation.PlayerIndex());
+	permanentLights[0].position = lightPosition;
+	permanentLights[1].position = lightPosition;
 
-	// Check lives
-	if(gameState.playerState.lives <= 0) {
-		// If all lives are lost, game over
-		GameOver();
+	// Create the vector of lights
+	std::vector<GameEngine::Light> lightsVector;
+	for (auto& light : permanentLights) {
+		lightsVector.push_back(light);
 	}
 
-	// Check if full speed should still be applied
-	if (gameState.playerState.isFullSpeed && Engine::GetElapsedTime() - gameState.playerState.forcedSpeedStart >= Constants::forcedSpeedTime) {
-		gameState.playerState.isFullSpeed = false;
-		gameState.playerState.playerSpeed = gameState.playerState.oldPlayerSpeed;
+	for (size_t i = 0; i < entities.Count(); ++i) {
+		if (entities.HasFlag(i, GameEngine::EntityFlags::IsLight)) {
+			lightsVector.push_back(entities.lights[i]);
+		}
 	}
-}
 
-void Skyroads::GameManager::RenderUI()
-{
-	// Render the fuel bar
-	GameEngine::GameObject fuelbar("fuelbar", glm::vec3(-0.9, 0, 0));
-	GameEngine::GameObject ufuelbar("ufuelbar", glm::vec3(-0.9, 0, -1));
+	// Upload the lights (once for all the objects)
+	lightBuffer.Update(lightsVector);
 
-	ufuelbar.setScale(Constants::fuelbarScale + Constants::fuelbarsDiff);
+	// Render objects
+	gpuProfiler.Begin("World");
+	RenderWorld();
+	gpuProfiler.End();
+	PrintRenderStats(deltaTimeSeconds);
 
-	float percent = gameState.playerState.fuel / Constants::maxFuel;
-	fuelbar.setScale(glm::vec3(Constants::fuelbarScale.x, Constants::fuelbarScale.y * percent, Constants::fuelbarScale.z));
+	PostProcessing();	// Post-Processing is not applied to the UI or Skybox
 
-	ufuelbar.Render2D();
-	fuelbar.Render2D();
+	gpuProfiler.Begin("UI");
+	UpdateGpuOverlay(deltaTimeSeconds);
+	RenderUI();
+	gpuProfiler.End();
+}
 
-	// Render the number of lifes
-	int lifesToRender = gameState.playerState.lives;
-	glm::vec3 pos = glm::vec3(0.9, -0.9, 0);
-	
-	while (lifesToRender > 0) {
-		GameEngine::GameObject life("life", pos);
-		life.Render2D();
+void GameManager::RenderWorld()
+{
+	const GameEngine::EntityStore& entities = simulation.getEntities();
+	renderStats = GameEngine::RenderStats();
+	frustum.Extract(camera->projectionMatrix * camera->GetViewMatrix());
+
+	// Interpolate, cull and record the draws of the objects in parallel, in a command buffer for
+	// every block of objects. The recording only reads the entities and doesn't use OpenGL. (A game
+	// has fewer objects than a block, so it is only split between threads in larger scenes.)
+	size_t blocks = (entities.Count() + Constants::objectsPerJob - 1) / Constants::objectsPerJob;
+	if (commandBuffers.size() < blocks) {
+		commandBuffers.resize(blocks);
+	}
+
+	auto recordStart = std::chrono::high_resolution_clock::now();
+	glm::vec3 eyePosition = camera->position;
+	glm::vec3 viewDirection = camera->forward;
+	jobs.ParallelFor(entities.Count(), Constants::objectsPerJob, [&](size_t begin, size_t end) {
+		// The range is larger than a block when it's not split, so every block is recorded separately
+		for (size_t blockBegin = begin; blockBegin < end; blockBegin += Constants::objectsPerJob) {
+			size_t blockEnd = std::min(blockBegin + Constants::objectsPerJob, end);
+			GameEngine::CommandBuffer& buffer = commandBuffers[blockBegin / Constants::objectsPerJob];
+			buffer.Clear();
+
+			for (size_t i = blockBegin; i < blockEnd; ++i) {
+				if (!entities.renders[i].isRendered) continue;
+
+				// Render the object between its last two simulated positions
+				GameEngine::TransformComponent transform = entities.transforms[i];
+				transform.position = InterpolatedPosition(i);
+
+				// Skip the objects outside the view (behind the camera, or far to the sides)
+				if (!IsVisible(i, transform.position)) {
+					buffer.Cull();
+					continue;
+				}
+				buffer.Record(transform, entities.renders[i], eyePosition, viewDirection, instancedRenderer);
+			}
+		}
+	});
 
-		lifesToRender--;
-		pos.y += 0.15f;
+	// Submit the recorded draws, in order
+	auto submitStart = std::chrono::high_resolution_clock::now();
+	for (size_t block = 0; block < blocks; ++block) {
+		commandBuffers[block].Submit(renderQueue, instancedRenderer, renderStats);
 	}
+
+	renderQueue.Flush(camera, renderStats);
+	instancedRenderer.Render(camera, renderStats);
+
+	auto submitEnd = std::chrono::high_resolution_clock::now();
+	renderStats.recordTime = std::chrono::duration<double, std::milli>(submitStart - recordStart).count();
+	renderStats.submitTime = std::chrono::duration<double, std::milli>(submitEnd - submitStart).count();
 }
 
-void GameManager::Update(float deltaTimeSeconds)
+bool GameManager::IsVisible(const size_t index, const glm::vec3& position)
 {
-	// Render skybox
-	RenderSkybox();
+	const GameEngine::EntityStore& entities = simulation.getEntities();
 
-	// Update the lights attached to the player
-	glm::vec3 lightPosition = gameObjects[0].getRigidBody().state.x;
-	permanentLights[0].position = lightPosition;
-	permanentLights[1].position = lightPosition;
+	// The meshes fit in a box of size 2 (the sphere has a radius of 1)
+	glm::vec3 scale = entities.transforms[index].scale;
+	glm::vec3 min = position - scale;
+	glm::vec3 max = position + scale;
 
-	UpdateGameState(deltaTimeSeconds);
+	if (entities.HasFlag(index, GameEngine::EntityFlags::HasCollider)) {
+		glm::vec3 colliderMin, colliderMax;
+		entities.colliders[index].getBounds(colliderMin, colliderMax);
 
-	// Create the vector of gameObjects
-	std::vector<GameEngine::GameObject*> gameObjectsVector;
-	for (auto& object : gameObjects) {
-		gameObjectsVector.push_back(&(object.second));
+		// The collider is at the simulated position, move it where the object is rendered
+		glm::vec3 offset = position - entities.transforms[index].position;
+		min = glm::min(min, colliderMin + offset);
+		max = glm::max(max, colliderMax + offset);
 	}
 
-	// Create the vector of lights
-	std::vector<GameEngine::Light> lightsVector;
-	for (auto& light : permanentLights) {
-		lightsVector.push_back(light);
+	return frustum.IsBoxVisible(min, max);
+}
+
+void GameManager::UpdateGpuOverlay(float deltaTimeSeconds)
+{
+	for (auto& id : profilerSprites) {
+		hud.Get(id).visible = showGpuOverlay;
 	}
+	if (!showGpuOverlay) return;
 
-	GameEngine::Light auxLight;
-	for (auto& object : gameObjects) {
-		if (object.second.getLight(&auxLight)) {
-			lightsVector.push_back(auxLight);
-		}
+	const float frameBudget = 1000.f / 60.f;	// In milliseconds
+	const float maxWidth = 0.6f;				// The width of a bar that takes the whole budget
+
+	// The passes are known after the first frames, add a bar for the new ones
+	while (profilerSprites.size() < gpuProfiler.PassCount()) {
+		GameEngine::Sprite bar;
+		bar.color = GameEngine::ObjectConstants::profilerColors[profilerSprites.size() % GameEngine::ObjectConstants::profilerColorCount];
+		profilerSprites.push_back(hud.Add(bar));
 	}
-	
-	
-	// For every gameObject types (type.first = id, type.second = the object)
-	for (auto& object : gameObjects) {
-		// Update position
-		object.second.UpdatePhysics(deltaTimeSeconds);
 
-		// Check collisions
-		CheckCollisions(object.second.ManageCollisions(gameObjectsVector, &gameObjects));
+	glm::vec2 position = glm::vec2(-0.95f, 0.9f);
+	for (size_t i = 0; i < gpuProfiler.PassCount(); ++i) {
+		float width = std::max(0.005f, (float)gpuProfiler.AverageMs(i) / frameBudget * maxWidth);
 
-		// Render objects
-		object.second.Render(camera, lightsVector);
-	};
+		// The bars are aligned to the left
+		GameEngine::Sprite& bar = hud.Get(profilerSprites[i]);
+		bar.position = position + glm::vec2(width / 2, 0);
+		bar.size = glm::vec2(width, 0.035f);
 
-	PostProcessing();	// Post-Processing is not applied to the UI or Skybox
-	RenderUI();
+		position.y -= 0.05f;
+	}
+
+	// There is no text rendering, so the names and values are printed
+	gpuStatsTimer += deltaTimeSeconds;
+	if (gpuStatsTimer < 1.f) return;
+	gpuStatsTimer = 0;
+
+	std::cout << "GPU (ms) -";
+	for (size_t i = 0; i < gpuProfiler.PassCount(); ++i) {
+		std::cout << " " << gpuProfiler.PassName(i) << ": " << gpuProfiler.AverageMs(i);
+	}
+	std::cout << "\n";
+}
+
+void GameManager::PrintRenderStats(float deltaTimeSeconds)
+{
+	if (!showRenderStats) return;
+
+	renderStatsTimer += deltaTimeSeconds;
+	if (renderStatsTimer < 1.f) return;
+	renderStatsTimer = 0;
+
+	std::cout << "Render (" << (renderQueue.IsSorting() ? "sorted" : "unsorted") << ") - "
+		<< "draw calls: " << renderStats.drawCalls
+		<< ", program switches: " << renderStats.programSwitches
+		<< ", texture switches: " << renderStats.textureSwitches
+		<< ", VAO switches: " << renderStats.vaoSwitches
+		<< ", visible objects: " << renderStats.visibleObjects
+		<< ", culled objects: " << renderStats.culledObjects
+		<< ", recording: " << renderStats.recordTime << " ms (" << jobs.ThreadCount() << " threads)"
+		<< ", submission: " << renderStats.submitTime << " ms"
+		<< ", UI draw calls: " << hud.DrawCalls() << "\n";
 }
 
 void GameManager::RenderSkybox() {
-	std::vector<GameEngine::Light> lights(0);
-	skybox.setPosition(gameObjects[0].getRigidBody().state.x);
-	skybox.Render(camera, lights);
+	skybox.setPosition(InterpolatedPosition(simulation.PlayerIndex()));
+	skybox.Render(camera);
 }
 
-void GameManager::PostProcessing() {
-	// Store the current screen resolution
-	glm::ivec2 resolution = window->GetResolution();
-	
+GLuint GameManager::PingPongBloom() {
 	// Copy data from the msaa framebuffer to the post-processing fx framebuffer
+	gpuProfiler.Begin("Resolve");
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, msaa_framebuffer);
 	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fx_framebuffer);
 	for (uint i = 0; i < 2; ++i) {
 		glReadBuffer(GL_COLOR_ATTACHMENT0 + i);
 		glDrawBuffer(GL_COLOR_ATTACHMENT0 + i);
-		glBlitFramebuffer(0, 0, 2560, 1440, 0, 0, 2560, 1440, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		glBlitFramebuffer(0, 0, renderResolution.x, renderResolution.y, 0, 0, renderResolution.x, renderResolution.y, GL_COLOR_BUFFER_BIT, GL_LINEAR);
 	}
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	gpuProfiler.End();
 
 	// Copy data from the bright msaa color buffer to the pp buffers
+	gpuProfiler.Begin("Bloom");
 	glBindFramebuffer(GL_READ_FRAMEBUFFER, msaa_framebuffer);
 	for (uint i = 0; i < 2; ++i) {
 		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, pp_framebuffers[i]);
 		glReadBuffer(GL_COLOR_ATTACHMENT1);
 		glDrawBuffer(GL_COLOR_ATTACHMENT0);
-		glBlitFramebuffer(0, 0, 2560, 1440, 0, 0, 2560, 1440, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+		glBlitFramebuffer(0, 0, renderResolution.x, renderResolution.y, 0, 0, renderResolution.x, renderResolution.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
 	}
  
 	// -- Apply the two-pass Gaussian Blur --
@@ -499,12 +726,12 @@ void GameManager::PostProcessing() {
 	bool horizontal = true;
 	glDisable(GL_DEPTH_TEST);
 	glClear(GL_DEPTH_BUFFER_BIT);
-	glViewport(0, 0, 2560, 1440);
+	glViewport(0, 0, renderResolution.x, renderResolution.y);
 	for (uint i = 0; i < Constants::blur_amount; ++i) {
 		// Activate the ping pong framebuffer
 		// Each iteration, we will fill one of the "pp" framebuffers with the other's color
 		glBindFramebuffer(GL_FRAMEBUFFER, pp_framebuffers[horizontal]);
-		glUniform1f(glGetUniformLocation(shaders["Blur"]->program, "horizontal"), (GLint)horizontal);
+		glUniform1f(shaders["Blur"]->GetCachedUniformLocation("horizontal"), (GLint)horizontal);
 
 		// Copy the color data to the ping-pong color buffer at the first iteration
 		glBindTexture(GL_TEXTURE_2D, i == 0 ? pp_colorbuffers[horizontal] : pp_colorbuffers[!horizontal]);
@@ -521,9 +748,42 @@ void GameManager::PostProcessing() {
 	glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fx_framebuffer);
 	glReadBuffer(GL_COLOR_ATTACHMENT0);
 	glDrawBuffer(GL_COLOR_ATTACHMENT1);
-	glBlitFramebuffer(0, 0, 2560, 1440, 0, 0, 2560, 1440, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	glBlitFramebuffer(0, 0, renderResolution.x, renderResolution.y, 0, 0, renderResolution.x, renderResolution.y, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+	gpuProfiler.End();
+
+	return fx_colorbuffers[1];
+}
+
+void GameManager::PostProcessing() {
+	// Store the current screen resolution
+	glm::ivec2 resolution = window->GetResolution();
+
+	GLuint bloomTexture;
+	float bloomStrength;
+	if (renderSettings.bloomMode == BloomMode::MipChain) {
+		// Only the scene color is resolved, the bright parts are extracted while downsampling
+		gpuProfiler.Begin("Resolve");
+		glBindFramebuffer(GL_READ_FRAMEBUFFER, msaa_framebuffer);
+		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, fx_framebuffer);
+		glReadBuffer(GL_COLOR_ATTACHMENT0);
+		glDrawBuffer(GL_COLOR_ATTACHMENT0);
+		glBlitFramebuffer(0, 0, renderResolution.x, renderResolution.y, 0, 0, renderResolution.x, renderResolution.y, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+
+		gpuProfiler.End();
+
+		glDisable(GL_DEPTH_TEST);
+		gpuProfiler.Begin("Bloom");
+		bloomTexture = bloom.Render(fx_colorbuffers[0], shaders["BloomDownsample"], shaders["BloomUpsample"], meshes["quad"], Constants::bloomThreshold);
+		gpuProfiler.End();
+		bloomStrength = Constants::bloomStrength;
+	}
+	else {
+		bloomTexture = PingPongBloom();
+		bloomStrength = 1.f;
+	}
 
 	// -- Blend the textures into the post-fx framebuffer and apply post-processing fx --
+	gpuProfiler.Begin("Tonemap");
 	glBindFramebuffer(GL_FRAMEBUFFER, 0);
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 	glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
@@ -533,19 +793,22 @@ void GameManager::PostProcessing() {
 	glBindVertexArray(meshes["quad"]->GetBuffers()->VAO);
 
 	// Load the two textures
-	GLuint shader_program = shaders["ScreenShader"]->program;
-	glUniform1i(glGetUniformLocation(shader_program, "screenTexture"), 0);
-	glUniform1i(glGetUniformLocation(shader_program, "bloomTexture"), 1);
+	Shader* screenShader = shaders["ScreenShader"];
+	glUniform1i(screenShader->GetCachedUniformLocation("screenTexture"), 0);
+	glUniform1i(screenShader->GetCachedUniformLocation("bloomTexture"), 1);
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, fx_colorbuffers[0]);
 
 	glActiveTexture(GL_TEXTURE1);
-	glBindTexture(GL_TEXTURE_2D, fx_colorbuffers[1]);
+	glBindTexture(GL_TEXTURE_2D, bloomTexture);
+	glActiveTexture(GL_TEXTURE0);
 
 	// Use the screen shader (Post-FX)
-	glUniform1f(glGetUniformLocation(shader_program, "gamma"), (GLfloat)Constants::gamma);
-	glUniform1f(glGetUniformLocation(shader_program, "exposure"), (GLfloat)Constants::exposure);
+	glUniform1f(screenShader->GetCachedUniformLocation("gamma"), (GLfloat)Constants::gamma);
+	glUniform1f(screenShader->GetCachedUniformLocation("exposure"), (GLfloat)Constants::exposure);
+	glUniform1f(screenShader->GetCachedUniformLocation("bloom_strength"), bloomStrength);
 	glDrawElements(meshes["quad"]->GetDrawMode(), static_cast<int>(meshes["quad"]->indices.size()), GL_UNSIGNED_SHORT, 0);
+	gpuProfiler.End();
 
 	glEnable(GL_DEPTH_TEST);
 }
@@ -554,251 +817,19 @@ void GameManager::FrameEnd()
 {
 }
 
-void Skyroads::GameManager::CheckCollisions(std::vector<int> collided)
-{
-	if (collided.size() == 0) return;
-
-	std::vector<int> toRemove;
-
-	for (int id : collided) {
-		std::string type = gameObjects[id].getType();
-		// Check platform collisions
-		if (type.rfind("platform_", 0) == 0) {
-			std::string color_string = type.substr(type.find("_") + 1);
-			if (color_string == "red") {
-				// Instant Loss
-				GameOver();
-			}
-			else if (color_string == "yellow") {
-				// Lose fuel
-				gameState.playerState.fuel -= Constants::fuelLoss;
-				gameObjects[0].setDistorted(Constants::powerAnimationTime);
-			}
-			else if (color_string == "orange") {
-				// Speed up
-				gameState.playerState.isFullSpeed = true;
-				gameState.playerState.forcedSpeedStart = Engine::GetElapsedTime();
-				gameState.playerState.oldPlayerSpeed = gameState.playerState.playerSpeed;
-				gameState.playerState.playerSpeed = Constants::maxSpeed;
-				gameObjects[0].setDistorted(Constants::forcedSpeedTime);
-			}
-			else if (color_string == "green") {
-				// Gain fuel
-				gameState.playerState.fuel += Constants::fuelGain;
-				gameObjects[0].setDistorted(Constants::powerAnimationTime);
-				if (gameState.playerState.fuel > Constants::maxFuel) {
-					gameState.playerState.fuel = Constants::maxFuel;
-				}
-			}
-			else if (color_string == "white") {
-				if (gameState.playerState.lives < Constants::maxLives) {
-					// Gain life
-					gameState.playerState.lives += 1;
-					gameObjects[0].setDistorted(Constants::powerAnimationTime);
-				}
-			}
-
-			gameObjects[id].setType("platform_purple");
-		}
-		else if (type.rfind("obstacle_", 0) == 0) {
-			std::string type_string = type.substr(type.find("_") + 1);
-			if (type_string == "good") {
-				gameState.collected++;
-				toRemove.push_back(id);
-			}
-			else if (type_string == "bad") {
-				gameState.playerState.lives--;
-				if (gameState.playerState.lives <= 0) {
-					GameOver();
-				}
-				toRemove.push_back(id);
-			}
-		}
-	}
-
-	for (auto& id : toRemove) {
-		gameObjects.erase(id);
-	}
-}
-
-void Skyroads::GameManager::ComputeScore()
-{
-	gameState.points = abs(gameObjects[0].getRigidBody().state.x.z - Constants::playerStartingPosition.z);
-}
-
 void Skyroads::GameManager::GameOver()
 {
 	std::cout << " --- Game Over --- " << "\n";
-	std::cout << " Your score was : " << (int)gameState.points + gameState.collected * 100 << "\n";
+	std::cout << " Your score was : " << simulation.getScore() << "\n";
+	if (recorder.IsOpen()) {
+		recorder.Close();
+		std::cout << " Recorded " << recorder.Ticks() << " ticks in '" << recordingPath << "'\n";
+	}
 	std::cout << " Press any key to exit ...\n";
 	int aux = _getch();
 	exit(0);
 }
 
-void GameManager::DecorationManagement() {
-	while (gameState.decorationCount < Constants::maxDecorations - 3) {
-		int renderDecoration = rand() % 100;
-
-		int side = rand() % 2;
-		float x = rand() % (int)(Constants::maxDecXOff - Constants::minDecXOff) + Constants::minDecXOff;
-		float y = rand() % (int)Constants::maxDecY;
-		float zoff = rand() % (int)(Constants::maxZOffset - Constants::minZOffset) + Constants::minZOffset;
-		float z;
-		if (side == 0) {
-			x = -x;
-			z = gameState.decorationLeftZ;
-			gameState.decorationLeftZ -= zoff;
-		}
-		else {
-			z = gameState.decorationRightZ;
-			gameState.decorationRightZ -= zoff;
-		}
-
-		glm::vec3 position(x, y, z);
-
-		x = (rand() % 100) / 100.f * 5.f;
-		y = (rand() % 100) / 100.f * 5.f;
-		z = (rand() % 100) / 100.f * 5.f;
-
-		if (renderDecoration < Constants::starPercent) {
-			GameEngine::GameObject star("star", position);
-			star.getRigidBody().addImpulse(glm::vec3(x, y, z));
-			addGameObject(star);
-			gameState.decorationCount++;
-			gameState.starsCount++;
-		}
-		else {
-			GameEngine::GameObject planet("planet", position);
-			planet.getRigidBody().addImpulse(glm::vec3(x, y, z));
-			addGameObject(planet);
-			gameState.decorationCount++;
-		}
-	}
-
-	// Check what decorations are out of sight (need to be removed)
-	std::vector<int> toRemove;
-	for (auto& object : gameObjects) {
-		if (object.second.getType() == "star" || object.second.getType() == "planet") {
-			if (glm::distance(object.second.getPosition(), gameObjects[0].getPosition()) > Constants::despawnDistance &&
-				object.second.getPosition().z > gameObjects[0].getPosition().z) {
-				toRemove.push_back(object.first);
-			}
-		}
-	}
-
-	// Remove the decorations
-	for (auto& id : toRemove) {
-		if (gameObjects[id].getType() == "star") {
-			gameState.starsCount--;
-		}
-		gameState.decorationCount--;
-		gameObjects.erase(id);
-	}
-}
-
-void GameManager::PlatformManagement()
-{
-	// This function manages all the platforms, their spawning and removal
-	// The platforms will be randomly spawned, many will be without effects.
-
-	if (gameState.platformCount < Constants::maxPlatforms) {
-		// Check the lane that hasn't spawn a platform in the longest time
-		std::vector<float> nps = gameState.nextPlatformSpawn;
-		int minLaneID = std::max_element(nps.begin(), nps.end()) - nps.begin(); // Max because the z is in descending order
-
-		int platType = rand() % 100;
-
-		if (gameState.platformCount < Constants::lanesX.size()) {
-			platType = 0;	// First platforms should be simple
-		}
-
-		int platGap = rand() % (Constants::maxPlatformGap - Constants::minPlatformGap) + Constants::minPlatformGap;
-
-		if (platType < Constants::simplePlatPercent) {
-			// Simple platform
-			GameEngine::GameObject platform("platform_blue", glm::vec3(Constants::lanesX[minLaneID], -0.125, nps[minLaneID]));
-			addGameObject(platform);
-		}
-		else {
-			// Effect platform
-			platType = (int)mapBetweenRanges(platType, Constants::simplePlatPercent, 100, 0, 9, 1);
-
-			if (platType < 1) {
-				// Red platform - very few
-				GameEngine::GameObject platform("platform_red", glm::vec3(Constants::lanesX[minLaneID], -0.125, nps[minLaneID]));
-				addGameObject(platform);
-			}
-			else if (platType < 4) {
-				// Yellow platform - some
-				GameEngine::GameObject platform("platform_yellow", glm::vec3(Constants::lanesX[minLaneID], -0.125, nps[minLaneID]));
-				addGameObject(platform);
-			}
-			else if (platType < 6) {
-				// Green platform - few
-				GameEngine::GameObject platform("platform_green", glm::vec3(Constants::lanesX[minLaneID], -0.125, nps[minLaneID]));
-				addGameObject(platform);
-			}
-			else if (platType < 8) {
-				// Orange platform - few
-				GameEngine::GameObject platform("platform_orange", glm::vec3(Constants::lanesX[minLaneID], -0.125, nps[minLaneID]));
-				addGameObject(platform);
-			}
-			else if (platType < 9) {
-				// White platform - very few
-				GameEngine::GameObject platform("platform_white", glm::vec3(Constants::lanesX[minLaneID], -0.125, nps[minLaneID]));
-				addGameObject(platform);
-			}
-		}
-
-		int obstacle = rand() % 100;
-		if (obstacle < Constants::obstaclesPercent) {
-			GameEngine::GameObject obstacle("obstacle_bad", glm::vec3(Constants::lanesX[1], 1, nps[minLaneID]));
-			addGameObject(obstacle);
-		}
-		else {
-			int collectible = rand() % 100;
-			if (collectible < Constants::pointsPercent) {
-				GameEngine::GameObject obstacle("obstacle_good", glm::vec3(Constants::lanesX[minLaneID], 1, nps[minLaneID]));
-				addGameObject(obstacle);
-			}
-		}
-
-		gameState.platformCount++;
-
-		// Update the next platform spawn for that lane
-		gameState.nextPlatformSpawn[minLaneID] -= GameEngine::ObjectConstants::platformLength + platGap;
-	}
-
-	// Check what platforms are out of sight (need to be removed)
-	std::vector<int> toRemove;
-	for (auto& object : gameObjects) {
-		if (object.second.getType().rfind("platform_", 0) == 0) {
-			if (object.second.getPosition().z > gameObjects[0].getPosition().z + GameEngine::ObjectConstants::platformLength / 2 + Constants::noSpawnRange) {
-				toRemove.push_back(object.first);
-			}
-		} else
-		if (object.second.getType().rfind("obstacle_", 0) == 0) {
-			if (object.second.getPosition().z > gameObjects[0].getPosition().z + GameEngine::ObjectConstants::platformLength / 2 + Constants::noSpawnRange) {
-				toRemove.push_back(object.first);
-			}
-		}
-	}
-	
-	// Remove the platforms
-	for (auto& id : toRemove) {
-		gameObjects.erase(id);
-		gameState.platformCount--;
-	}
-
-	// Update the nextPlatformSpawn in case it got too low
-	for (int i = 0; i < gameState.nextPlatformSpawn.size(); ++i) {
-		// A next platform z is too low if the distance between it's center and the player's center (on the Z axis) is greater than the despawn range 
-		if (gameState.nextPlatformSpawn[i] > gameObjects[0].getPosition().z - Constants::noSpawnRange) {
-			gameState.nextPlatformSpawn[i] = gameObjects[0].getPosition().z - 2 * Constants::noSpawnRange;
-		}
-	}
-}
-
 void GameManager::OnInputUpdate(float deltaTime, int mods)
 {
 }
@@ -809,23 +840,56 @@ void GameManager::OnKeyPress(int key, int mods)
 	switch (key) {
 	case GLFW_KEY_C: {
 		// Change camera modes
-		gameState.cameraSettings.cameraMode = !gameState.cameraSettings.cameraMode;
-		gameState.cameraSettings.cameraRotation = glm::vec2(0);
+		cameraSettings.cameraMode = !cameraSettings.cameraMode;
+		cameraSettings.cameraRotation = glm::vec2(0);
 	} break;
 	case GLFW_KEY_SPACE: {
 		// Jump
-		if (!gameObjects[0].isInJump) {
-			gameObjects[0].isInJump = true;
-			gameObjects[0].getRigidBody().state.v.y = 4.f;
-		}
+		jumpRequested = true;
+	} break;
+	case GLFW_KEY_F3: {
+		// Print the render stats
+		showRenderStats = !showRenderStats;
+		renderStatsTimer = 1.f;
+	} break;
+	case GLFW_KEY_F4: {
+		// Toggle the sorting of the render queue (to compare the state changes)
+		renderQueue.SetSorting(!renderQueue.IsSorting());
+	} break;
+	case GLFW_KEY_F5: {
+		// Decrease the render scale
+		renderSettings.renderScale = std::max(0.25f, renderSettings.renderScale - 0.25f);
+		ResizeFramebuffers();
+	} break;
+	case GLFW_KEY_F6: {
+		// Increase the render scale
+		renderSettings.renderScale = std::min(2.f, renderSettings.renderScale + 0.25f);
+		ResizeFramebuffers();
+	} break;
+	case GLFW_KEY_F7: {
+		// Cycle the MSAA sample count (1, 2, 4, ... up to the maximum supported by the driver)
+		GLint maxSamples = 1;
+		glGetIntegerv(GL_MAX_SAMPLES, &maxSamples);
+		renderSettings.samples = renderSettings.samples * 2 > (unsigned int)maxSamples ? 1 : renderSettings.samples * 2;
+		ResizeFramebuffers();
+	} break;
+	case GLFW_KEY_F8: {
+		// Switch between the mip-chain bloom and the full resolution blur
+		renderSettings.bloomMode = renderSettings.bloomMode == BloomMode::MipChain ? BloomMode::PingPong : BloomMode::MipChain;
+		std::cout << "Bloom: " << (renderSettings.bloomMode == BloomMode::MipChain ? "mip chain" : "ping-pong blur") << "\n";
+	} break;
+	case GLFW_KEY_F9: {
+		// Show the GPU times of the render passes
+		showGpuOverlay = !showGpuOverlay;
+		gpuStatsTimer = 1.f;
 	} break;
 	/*case GLFW_KEY_KP_SUBTRACT: {
-		gameState.cameraSettings.distanceToTarget += 0.25f;
-		std::cout << "New zoom " << gameState.cameraSettings.distanceToTarget << "\n";
+		cameraSettings.distanceToTarget += 0.25f;
+		std::cout << "New zoom " << cameraSettings.distanceToTarget << "\n";
 	} break;
 	case GLFW_KEY_KP_ADD: {
-		gameState.cameraSettings.distanceToTarget -= 0.25f;
-		std::cout << "New zoom " << gameState.cameraSettings.distanceToTarget << "\n";
+		cameraSettings.distanceToTarget -= 0.25f;
+		std::cout << "New zoom " << cameraSettings.distanceToTarget << "\n";
 	} break;*/
 	case GLFW_KEY_ESCAPE: {
 		exit(-1);
@@ -847,7 +911,7 @@ void GameManager::OnMouseMove(int mouseX, int mouseY, int deltaX, int deltaY)
 
 		float sensitivityOX = 0.001f;
 		float sensitivityOY = 0.001f;
-		glm::vec2 rotation = gameState.cameraSettings.cameraRotation;
+		glm::vec2 rotation = cameraSettings.cameraRotation;
 
 		rotation += glm::vec2(-sensitivityOX * deltaY, -sensitivityOY * deltaX);
 
@@ -856,13 +920,13 @@ void GameManager::OnMouseMove(int mouseX, int mouseY, int deltaX, int deltaY)
 		if (rotation.y > yLimit) rotation.y = yLimit;
 		if (rotation.y < -yLimit) rotation.y = -yLimit;
 
-		gameState.cameraSettings.cameraRotation = rotation;
+		cameraSettings.cameraRotation = rotation;
 	}
 }
 
 void GameManager::OnMouseScroll(int mouseX, int mouseY, int offsetX, int offsetY) {
 	if (window->MouseHold(GLFW_MOUSE_BUTTON_RIGHT)) {
-		float distance = gameState.cameraSettings.distanceToTarget;
+		float distance = cameraSettings.distanceToTarget;
 		float maxZoom = 2.5f;
 		float minZoom = 5.0f;
 
@@ -873,8 +937,14 @@ void GameManager::OnMouseScroll(int mouseX, int mouseY, int offsetX, int offsetY
 		if (distance > minZoom) distance = minZoom;
 		if (distance < maxZoom) distance = maxZoom;
 
-		gameState.cameraSettings.distanceToTarget = distance;
+		cameraSettings.distanceToTarget = distance;
 
 		std::cout << distance << "\n";
 	}
 }
+
+void GameManager::OnWindowResize(int width, int height)
+{
+	// The render targets follow the size of the window
+	ResizeFramebuffers();
+}
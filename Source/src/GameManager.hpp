@@ -13,103 +13,40 @@
 #include <stb/stb_image.h>
 #include <stb/stb_image_write.h>
 #include "GameEngine/GameObject.hpp"
+#include "GameSimulation.hpp"
+#include "InputRecording.hpp"
 #include "GameEngine/Camera.hpp"
 #include "GameEngine/Lighting.hpp"
+#include "GameEngine/LightBuffer.hpp"
+#include "GameEngine/InstancedRenderer.hpp"
+#include "GameEngine/RenderQueue.hpp"
+#include "GameEngine/CommandBuffer.hpp"
+#include "GameEngine/Frustum.hpp"
+#include "GameEngine/BloomRenderer.hpp"
+#include "GameEngine/GpuProfiler.hpp"
+#include "GameEngine/TextureLoader.hpp"
+#include "GameEngine/CompressedTexture.hpp"
+#include "GameEngine/BakedMesh.hpp"
+#include "GameEngine/SpriteBatch.hpp"
 #include "GameEngine/Objects.hpp"
 
 namespace Skyroads {
-	namespace Constants {
-		const std::vector<std::string> platformTypes{ "platform_red", "platform_green", "platform_yellow", "platform_orange", "platform_purple", "platform_blue", "platform_white" };
-		const std::vector<std::string> shaderNames{ "Base", "UI", "ScreenShader", "Skybox", "Blur", "Spaceship", "EmmisiveTransparency", "Planet" };
-		const std::vector<std::string> meshNames{ "box", "sphere"};
-		const std::vector<std::string> textureNames{ "life", "skybox", "spaceship_window", "spaceship_exhaust", "icy", "jupiter", "mars", "neptune", "star_blue", "star_red", "uranus", "venus", "obstacle1", "obstacle2" };
-		const std::vector<std::string> modelNames{ "platform", "spaceship" };
-
-		const glm::vec3 lightPositionOffset = glm::vec3(0., 7.75f, 0.);
-		const glm::vec3 playerStartingPosition = glm::vec3(0, 20.f, 35.f);
-
-		const std::vector<float> lanesX{ -3.5f, 0.f, 3.5f };
-
-		// Player constants
-		const float maxSpeed = 0.125f;
-		const float minSpeed = 0.0075f;
-		const float speedStep = 0.001f;
-		const float lateralSpeed = .75f;
-
-		// Game Constants
-		const float forcedSpeedTime = 5;		// In seconds
-		const double powerAnimationTime = 2;	// In seconds
-		const float maxLives = 3;
-		const int maxPlatforms = 12;
-		const int minPlatformGap = 5;
-		const int maxPlatformGap = GameEngine::ObjectConstants::platformLength;
-		const int simplePlatPercent = 60;
-		const float noSpawnRange = 10.f;
-		const float outOfBoundY = -3.5f;
-		const int obstaclesPercent = 10;
-		const int pointsPercent = 10;
-		
-		// Fuel constants
-		const float maxFuel = 100.f;
-		const float fuelGain = 0.33f * maxFuel;
-		const float fuelLoss = 0.10f * maxFuel;
-		const float fuelFlow = 2.5f;									// The "fuelFlow" factor
-		const glm::vec3 fuelbarScale = glm::vec3(0.07, 1.9f, 1);		// The maximum scale/size of the fuelbar
-		const float fuelbarsDiff = 0.01;
-
-		// Camera constants
-		const float minFov = 60.f;
-		const float maxFov = 90.f;
-
-		// Decoration constants
-		const int maxDecorations = 16;
-		const int maxStars = 2;
-		const float starPercent = 5.f;
-		const float minZOffset = 5.f;
-		const float maxZOffset = 30.f;
-		const float despawnDistance = 10.f;
-		const float maxDecY = 15.f;
-		const float minDecXOff = 6.5f;
-		const float maxDecXOff = 35.f;
-
-		// Rendering constants
-		const float gamma = 1.2f;
-		const float exposure = 0.5f;
-		const unsigned int multisamples = 16;
-		const unsigned int blur_amount = 10;	// Blur iterations
+	// The settings of the camera (not part of the game logic)
+	struct CameraSettings {
+		float cameraFOV = 75.f;
+		bool cameraMode = true;
+		glm::vec2 cameraRotation = glm::vec2(0);
+		float distanceToTarget = 2.25f;
 	};
 
-	// Defines variables used in the game logic
-	struct GameState {
-		struct CameraSettings {
-			float cameraFOV = 75.f;
-			bool cameraMode = true;
-			glm::vec2 cameraRotation = glm::vec2(0);
-			float distanceToTarget = 2.25f;
-		};
-		CameraSettings cameraSettings;
+	// How the bloom is computed - a downsampled mip chain, or the full resolution gaussian blur
+	enum class BloomMode { MipChain, PingPong };
 
-		struct PlayerState {
-			float fuel = Constants::maxFuel;
-			bool isFullSpeed = false;
-			double forcedSpeedStart = 0;	// The start time of the forced speed effect
-			float lives = 1;
-			float playerSpeed = 0.05f;
-			float oldPlayerSpeed = 0.05f;   // The speed of the player before the forced speed effect
-		};
-		PlayerState playerState;
-
-		float points = 0.f;
-		float collected = 0;	// How many good objects he has collected
-
-		// Data related to the platforms and decorations
-		std::vector<float> nextPlatformSpawn = {Constants::playerStartingPosition.z, Constants::playerStartingPosition.z + 1, Constants::playerStartingPosition.z };
-		int platformCount = 0;
-		int decorationCount = 0;
-		int starsCount = 0;
-		bool gameStarted;
-		int decorationLeftZ = 0;
-		int decorationRightZ = 0;
+	// The settings of the render targets (can be changed while the game is running)
+	struct RenderSettings {
+		float renderScale = Constants::renderScale;
+		unsigned int samples = Constants::multisamples;
+		BloomMode bloomMode = BloomMode::MipChain;
 	};
 
 	class GameManager : public SimpleScene
@@ -118,98 +55,161 @@ namespace Skyroads {
 		GameManager();
 		~GameManager();
 		void Init() override;
-		
-		void addGameObject(GameEngine::GameObject object);
 
 		/// <summary>
-		/// Get the game object with a specific id
+		/// Record the game in a file (the seed and the input of every tick), so it can be replayed
+		/// with Benchmarks::Replay. Must be called before Init.
 		/// </summary>
-		/// <param name="id">The id of the game object</param>
-		/// <returns>The game object</returns>
-		GameEngine::GameObject* getGameObject(const long int id);
+		/// <param name="path">The recording file</param>
+		void Record(const std::string& path);
 
 	private:
 		/// <summary>
-		/// A map of all the gameobjects, using the object id as a key
+		/// The game logic. The game manager only renders its state and forwards the input
 		/// </summary>
-		std::unordered_map<long int, GameEngine::GameObject> gameObjects;
+		GameSimulation simulation;
+		bool jumpRequested;		// Set when the jump key is pressed, used in the next tick
+		GameEngine::JobSystem jobs;		// Updates the objects in parallel (physics, culling, draw recording)
+		InputRecorder recorder;
+		std::string recordingPath;		// Empty if the game is not recorded
 		std::unordered_map<std::string, Texture2D*> textures;
 		GameEngine::GameObject skybox;
 
 		GameEngine::Camera* camera;
-		GameState gameState;
+		CameraSettings cameraSettings;
 
 		std::vector<GameEngine::Light> permanentLights;		// Player + Ambient lights
+		GameEngine::LightBuffer lightBuffer;				// The lights of the frame, shared by all the shaders
+		GameEngine::InstancedRenderer instancedRenderer;	// Draws the objects with the same mesh together
+		GameEngine::RenderQueue renderQueue;				// Draws the other objects, sorted by their state
+		GameEngine::Frustum frustum;						// The view frustum of the camera, in the current frame
+		std::vector<GameEngine::CommandBuffer> commandBuffers;	// The draws of the objects, one buffer for every block of objects
+
+		GameEngine::RenderStats renderStats;	// The state changes of the last frame
+		bool showRenderStats;					// Print the render stats (once per second)
+		float renderStatsTimer;
+
+		GameEngine::GpuProfiler gpuProfiler;	// The GPU time of the render passes
+		bool showGpuOverlay;					// Draw the GPU times (and print them once per second)
+		float gpuStatsTimer;
+
+		GameEngine::SpriteBatch hud;					// The UI, kept between frames and drawn with one draw call
+		unsigned int fuelbarSprite;
+		std::vector<unsigned int> lifeSprites;
+		std::vector<unsigned int> scoreSprites;		// The 7 segments of every digit of the score
+		std::vector<unsigned int> profilerSprites;	// The bars of the GPU overlay, one for every pass
+
+		RenderSettings renderSettings;
+		glm::ivec2 renderResolution;		// The size of the render targets (window resolution * render scale)
 
 		// Different buffers used for rendering
 		unsigned int msaa_framebuffer, fx_framebuffer, pp_framebuffers[2];
 		unsigned int msaa_colorbuffers[2], fx_colorbuffers[2], pp_colorbuffers[2];
 		unsigned int msaa_renderbuffer;
+		GameEngine::BloomRenderer bloom;
 
 		void LoadShader(std::string name, std::string shadersPath);
 		void LoadMesh(std::string name, std::string meshesPath);
 		void LoadTexture(std::string name, std::string extension, std::string texturesPath);
 
+		/// <summary>
+		/// Load all the textures (of the game and of the models) and print how long it took
+		/// </summary>
+		void LoadTextures();
+
+		/// <summary>
+		/// Load the baked (compressed) version of a texture, if it exists
+		/// </summary>
+		/// <param name="name">The name of the texture</param>
+		/// <param name="texturesPath">The directory of the texture</param>
+		/// <returns>If the texture was loaded</returns>
+		bool LoadCompressedTexture(std::string name, std::string texturesPath);
+
 		void FrameStart() override;
+		void FixedUpdate(float fixedDeltaTimeSeconds) override;
 		void Update(float deltaTimeSeconds) override;
 		void FrameEnd() override;
 
+		/// <summary>
+		/// Get the position of an object at the current frame, interpolated between
+		/// its last two simulated positions
+		/// </summary>
+		/// <param name="index">The index of the object in the entity arrays</param>
+		/// <returns>The position</returns>
+		glm::vec3 InterpolatedPosition(const size_t index);
+
 		/// <summary>
 		/// Update the camera data
 		/// </summary>
 		void UpdateCamera();
 
 		/// <summary>
-		/// Update the player data
+		/// Create the sprites of the UI
 		/// </summary>
-		void UpdatePlayer();
+		void InitHud();
 
 		/// <summary>
-		/// Update all the data related to the game logic
+		/// Update the sprites of the UI (fuel, lives, score) and draw them
 		/// </summary>
-		void UpdateGameState(const float deltaTime);
+		void RenderUI();
 
 		/// <summary>
-		/// Render the UI
+		/// Render every object in the scene (that is inside the view frustum)
 		/// </summary>
-		void RenderUI();
+		void RenderWorld();
+
+		/// <summary>
+		/// Check if an object can be seen by the camera, using its collider bounds
+		/// (and its scale, for the objects whose mesh is larger than their collider)
+		/// </summary>
+		/// <param name="index">The index of the object in the entity arrays</param>
+		/// <param name="position">The position the object is rendered at</param>
+		/// <returns>If it may be visible</returns>
+		bool IsVisible(const size_t index, const glm::vec3& position);
 
 		/// <summary>
-		/// Check collisions and update the game state
+		/// Show the average GPU time of every pass as a bar in the UI (the full width is a 60 FPS frame), if enabled
 		/// </summary>
-		/// <param name="collided">A vector with the id's of the collided objects</param>
-		void CheckCollisions(std::vector<int> collided);
+		/// <param name="deltaTimeSeconds">The duration of the frame</param>
+		void UpdateGpuOverlay(float deltaTimeSeconds);
 
 		/// <summary>
-		/// Compute the score
+		/// Print the state changes of the last frame, if enabled
 		/// </summary>
-		void ComputeScore();
+		/// <param name="deltaTimeSeconds">The duration of the frame</param>
+		void PrintRenderStats(float deltaTimeSeconds);
 
 		/// <summary>
-		/// Function that handles the game end
+		/// Function that handles the game end (print the score and exit)
 		/// </summary>
 		void GameOver();
 
 		/// <summary>
-		/// Spawn/Remove platforms/obstacles from the game
+		/// Initialise the framebuffers, with the size of the window scaled by the render scale
 		/// </summary>
-		void PlatformManagement();
+		void InitFramebuffers();
 
 		/// <summary>
-		/// Spawn/Remove decorative elements from the game
+		/// Delete the framebuffers and their attachments
 		/// </summary>
-		void DecorationManagement();
+		void DeleteFramebuffers();
 
 		/// <summary>
-		/// Initialise the framebuffers
+		/// Recreate the framebuffers (after the window or the render settings changed)
 		/// </summary>
-		void InitFramebuffers();
+		void ResizeFramebuffers();
 
 		/// <summary>
 		/// Apply postprocessing
 		/// </summary>
 		void PostProcessing();
 
+		/// <summary>
+		/// Compute the bloom using the bright color buffer and a full resolution two-pass gaussian blur
+		/// </summary>
+		/// <returns>The texture with the bloom</returns>
+		GLuint PingPongBloom();
+
 		/// <summary>
 		/// Render the skybox
 		/// </summary>
@@ -220,5 +220,6 @@ namespace Skyroads {
 		void OnKeyRelease(int key, int mods) override;
 		void OnMouseMove(int mouseX, int mouseY, int deltaX, int deltaY) override;
 		void OnMouseScroll(int mouseX, int mouseY, int offsetX, int offsetY) override;
+		void OnWindowResize(int width, int height) override;
 	};
 }
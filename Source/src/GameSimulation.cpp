@@ -0,0 +1,582 @@
+#include "GameSimulation.hpp"
+#include "TrackGenerator.hpp"
+
+#include <algorithm>
+#include <math.h>
+
+/// <summary>
+/// Map a value that is in a range to another range
+/// </summary>
+/// <param name="sourceNumber">The value</param>
+/// <param name="fromA">Starting value of the first range</param>
+/// <param name="fromB">End value of the first range</param>
+/// <param name="toA">Starting value of the second range</param>
+/// <param name="toB">End value of the second range</param>
+/// <param name="decimalPrecision">The number of decimals to use</param>
+/// <returns>The mapped value</returns>
+double Skyroads::mapBetweenRanges(double sourceNumber, double fromA, double fromB, double toA, double toB, int decimalPrecision) {
+	double deltaA = fromB - fromA;
+	double deltaB = toB - toA;
+	double scale = deltaB / deltaA;
+	double negA = -1 * fromA;
+	double offset = (negA * scale) + toA;
+	double finalNumber = (sourceNumber * scale) + offset;
+	int calcScale = (int)pow(10, decimalPrecision);
+	return (double)round(finalNumber * calcScale) / calcScale;
+}
+
+using namespace Skyroads;
+
+GameSimulation::GameSimulation() : jobs(nullptr), track(new TrackGenerator()), time(0), gameOver(false), seed(0), entityCapacity(0)
+{
+}
+
+GameSimulation::~GameSimulation()
+{
+}
+
+void GameSimulation::Init(const unsigned int seed)
+{
+	using namespace GameEngine;
+
+	time = 0;
+	gameOver = false;
+	this->seed = seed;
+	track->Start(seed);
+	decorationRandom.Seed(seed, RandomStreams::Decorations);
+
+	// Reserve space for all the platforms, obstacles and decorations. The slots of the removed
+	// objects are reused, so spawning doesn't allocate memory after this
+	size_t capacity = 1 + 2 * Constants::maxPlatforms + Constants::maxDecorations;
+	entityCapacity = capacity;
+	entities.Reserve(capacity);
+	broadphase.Reserve(capacity);
+	broadphasePairs.reserve(capacity);
+	batchIndices.reserve(capacity);
+	collided.reserve(capacity);
+	toRemove.reserve(capacity);
+
+	// The objects that are spawned while the game runs
+	std::vector<ObjectType> archetypes;
+	for (unsigned char color = 0; color < (unsigned char)PlatformColor::Count; ++color) {
+		archetypes.push_back(ObjectType::Platform((PlatformColor)color));
+	}
+	archetypes.push_back(ObjectType::Obstacle(ObstacleKind::Good));
+	archetypes.push_back(ObjectType::Obstacle(ObstacleKind::Bad));
+	for (unsigned char kind = 0; kind < ObjectConstants::planetKinds; ++kind) {
+		archetypes.push_back(ObjectType(ObjectCategory::Planet, kind));
+	}
+	for (unsigned char kind = 0; kind < ObjectConstants::starKinds; ++kind) {
+		archetypes.push_back(ObjectType(ObjectCategory::Star, kind));
+	}
+	spawnPool.Init(archetypes);
+
+	// Initialize the player object
+	GameObject player(ObjectCategory::Player, glm::vec3(Constants::playerStartingPosition));
+	player.getRigidBody().state.drag_coef = 10.f;
+	this->player = addGameObject(player);
+}
+
+void GameSimulation::SetJobSystem(GameEngine::JobSystem* jobs)
+{
+	this->jobs = jobs;
+}
+
+void GameSimulation::Tick(const TickInput& input, const float deltaTime)
+{
+	time += deltaTime;
+
+	// Keep the last positions, for the render interpolation
+	for (auto& transform : entities.transforms) {
+		transform.previousPosition = transform.position;
+	}
+
+	UpdateGameState(input, deltaTime);
+
+	// Update positions
+	UpdatePhysics(deltaTime);
+
+	// Check collisions
+	CheckCollisions(ManageCollisions());
+}
+
+GameEngine::EntityHandle GameSimulation::addGameObject(const GameEngine::GameObject& object)
+{
+	GameEngine::EntityHandle handle = entities.Create(object);
+	size_t index = entities.IndexOf(handle);
+	if (entities.HasFlag(index, GameEngine::EntityFlags::HasCollider)) {
+		broadphase.Insert(handle.index, entities.colliders[index]);
+	}
+	return handle;
+}
+
+GameEngine::EntityHandle GameSimulation::spawnGameObject(const GameEngine::ObjectType type, const glm::vec3& position)
+{
+	GameEngine::EntityHandle handle = spawnPool.Spawn(entities, type, position);
+	size_t index = entities.IndexOf(handle);
+	if (entities.HasFlag(index, GameEngine::EntityFlags::HasCollider)) {
+		broadphase.Insert(handle.index, entities.colliders[index]);
+	}
+	return handle;
+}
+
+void GameSimulation::removeGameObject(const GameEngine::EntityHandle handle)
+{
+	if (!entities.IsAlive(handle)) return;
+	broadphase.Remove(handle.index);
+	entities.Destroy(handle);
+}
+
+size_t GameSimulation::PlayerIndex() const
+{
+	return entities.IndexOf(player);
+}
+
+bool GameSimulation::isGameOver() const
+{
+	return gameOver;
+}
+
+int GameSimulation::getScore() const
+{
+	return (int)gameState.points + (int)gameState.collected * 100;
+}
+
+double GameSimulation::getTime() const
+{
+	return time;
+}
+
+unsigned int GameSimulation::getSeed() const
+{
+	return seed;
+}
+
+uint64_t GameSimulation::StateHash() const
+{
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto add = [&hash](const void* data, const size_t size) {
+		const unsigned char* bytes = (const unsigned char*)data;
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ bytes[i]) * 0x100000001B3ull;
+		}
+	};
+
+	int score = getScore();
+	size_t count = entities.transforms.size();
+	add(&time, sizeof(time));
+	add(&score, sizeof(score));
+	add(&gameState.playerState.fuel, sizeof(float));
+	add(&gameState.playerState.lives, sizeof(float));
+	add(&gameState.playerState.playerSpeed, sizeof(float));
+	add(&count, sizeof(count));
+	for (auto& transform : entities.transforms) {
+		add(&transform.position, sizeof(transform.position));
+	}
+	return hash;
+}
+
+GameEngine::EntityStore& GameSimulation::getEntities()
+{
+	return entities;
+}
+
+GameState& GameSimulation::getGameState()
+{
+	return gameState;
+}
+
+void GameSimulation::UpdatePlayer(const TickInput& input)
+{
+	float pSpeed = gameState.playerState.playerSpeed;
+	GameEngine::RigidBody& playerBody = entities.bodies[PlayerIndex()];
+
+	// Move the player forward
+	playerBody.state.x.z -= gameState.playerState.playerSpeed;
+
+	if (input.isPressed(InputKeys::Left)) {
+		// Move player left
+		playerBody.addImpulse(-Constants::lateralSpeed, 0, 0);
+	}
+	else if (input.isPressed(InputKeys::Right)) {
+		// Move player right
+		playerBody.addImpulse(Constants::lateralSpeed, 0, 0);
+	}
+	else if (input.isPressed(InputKeys::Faster)) {
+		if (!gameState.playerState.isFullSpeed) {
+			// Speed up
+			pSpeed += Constants::speedStep;
+			if (pSpeed > Constants::maxSpeed) {
+				pSpeed = Constants::maxSpeed;
+			}
+		}
+	}
+	else if (input.isPressed(InputKeys::Slower)) {
+		if (!gameState.playerState.isFullSpeed) {
+			// Slow down
+			pSpeed -= Constants::speedStep;
+			if (pSpeed < Constants::minSpeed) {
+				pSpeed = Constants::minSpeed;
+			}
+		}
+	}
+
+	// Jump
+	if (input.isPressed(InputKeys::Jump) && !gameState.playerState.isInJump) {
+		gameState.playerState.isInJump = true;
+		playerBody.state.v.y = 4.f;
+	}
+
+	// Check if the player has fallen
+	if (entities.transforms[PlayerIndex()].position.y < Constants::outOfBoundY) {
+		GameOver();
+	}
+
+	gameState.playerState.playerSpeed = pSpeed;
+}
+
+void GameSimulation::UpdateGameState(const TickInput& input, const float deltaTime)
+{
+	// Update Player
+	UpdatePlayer(input);
+
+	// Compute the current score
+	ComputeScore();
+	
+	// Update the platforms
+	PlatformManagement();
+
+	// Update the decorations
+	DecorationManagement();
+
+	// Check fuel state
+	float speedFuelFactor = mapBetweenRanges(gameState.playerState.playerSpeed, Constants::minSpeed, Constants::maxSpeed, 0.5, 1.5, 1);
+	gameState.playerState.fuel -= deltaTime * Constants::fuelFlow * speedFuelFactor;
+	if (gameState.playerState.fuel <= 0) {
+		// If all the fuel was used, a life is lost. If the game can go on
+		// (at least 1 life remaining), reset the fuel to max
+
+		gameState.playerState.lives--;
+		if (gameState.playerState.lives > 0) {
+			gameState.playerState.fuel = Constants::maxFuel;
+		}
+	}
+
+	// Check lives
+	if(gameState.playerState.lives <= 0) {
+		// If all lives are lost, game over
+		GameOver();
+	}
+
+	// Check if full speed should still be applied
+	if (gameState.playerState.isFullSpeed && time - gameState.playerState.forcedSpeedStart >= Constants::forcedSpeedTime) {
+		gameState.playerState.isFullSpeed = false;
+		gameState.playerState.playerSpeed = gameState.playerState.oldPlayerSpeed;
+	}
+}
+
+void GameSimulation::UpdatePhysics(const float deltaTime)
+{
+	using namespace GameEngine;
+
+	// Gather the simulated bodies, so they are all integrated together
+	batchIndices.clear();
+	for (size_t i = 0; i < entities.Count(); ++i) {
+		RigidBody& body = entities.bodies[i];
+		if (!body.physics_enabled) continue;
+
+		if (body.m_type == PhysicsConstants::Motion_Type::SIMULATED) {
+			batchIndices.push_back(i);
+		}
+		else {
+			PhysixEngine::UpdatePhysics(body, deltaTime);
+		}
+	}
+
+	// Every block of bodies is loaded, integrated and stored by the same job. The blocks start
+	// at multiples of 8, so the results don't depend on the number of threads.
+	bodyBatch.Resize(batchIndices.size());
+	auto integrate = [this, deltaTime](size_t begin, size_t end) {
+		for (size_t j = begin; j < end; ++j) {
+			bodyBatch.Load(j, entities.bodies[batchIndices[j]].state);
+		}
+		PhysixEngine::IntegrateBatch(bodyBatch, begin, end, deltaTime);
+		for (size_t j = begin; j < end; ++j) {
+			bodyBatch.Store(j, entities.bodies[batchIndices[j]].state);
+		}
+	};
+
+	if (jobs != nullptr) {
+		jobs->ParallelFor(batchIndices.size(), Constants::bodiesPerJob, integrate);
+	}
+	else {
+		integrate(0, batchIndices.size());
+	}
+
+	for (size_t i = 0; i < entities.Count(); ++i) {
+		RenderComponent& render = entities.renders[i];
+		if (render.distortedTime > 0) render.distortedTime -= deltaTime;
+
+		// Update the position from the physics engine
+		entities.transforms[i].position = entities.bodies[i].state.x;
+		entities.colliders[i].setPosition(entities.transforms[i].position);
+		if (entities.HasFlag(i, EntityFlags::HasCollider)) {
+			broadphase.Update(entities.handles[i].index, entities.colliders[i]);
+		}
+	}
+}
+
+const std::vector<GameEngine::EntityHandle>& GameSimulation::ManageCollisions()
+{
+	size_t playerIndex = PlayerIndex();
+	const GameEngine::Collider& playerCollider = entities.colliders[playerIndex];
+
+	collided.clear();
+	bool onPlatform = false;
+
+	// Only player collisions matter. The broadphase returns the pairs that may collide,
+	// and only those are checked
+	broadphase.FindPairs(broadphasePairs);
+	for (auto& pair : broadphasePairs) {
+		unsigned int other;
+		if (pair.first == player.index) other = pair.second;
+		else if (pair.second == player.index) other = pair.first;
+		else continue;
+
+		size_t i = entities.IndexOf(entities.GetHandle(other));
+		const GameEngine::ObjectType type = entities.types[i];
+		bool isPlatform = type.is(GameEngine::ObjectCategory::Platform);
+		if (!isPlatform && !type.is(GameEngine::ObjectCategory::Obstacle)) continue;
+
+		if (GameEngine::CollisionManager::isCollision(playerCollider, entities.colliders[i])) {
+			collided.push_back(entities.handles[i]);
+			onPlatform = onPlatform || isPlatform;
+		}
+	}
+
+	// Update the physics of the player if he collided with a platform
+	// This will actually just mean that the player will "stick" to the platform
+	GameEngine::RigidBody& body = entities.bodies[playerIndex];
+	using namespace GameEngine::ObjectConstants;
+	if (onPlatform && body.state.x.y > -playerHeight / 4) {
+		body.state.v.y = 0;
+		body.state.x.y = platformTopHeight + playerHeight / 4;
+		gameState.playerState.isInJump = false;
+	}
+
+	return collided;
+}
+
+void GameSimulation::CheckCollisions(const std::vector<GameEngine::EntityHandle>& collided)
+{
+	if (collided.size() == 0) return;
+
+	toRemove.clear();
+
+	for (auto& handle : collided) {
+		size_t id = entities.IndexOf(handle);
+		const GameEngine::ObjectType type = entities.types[id];
+		// Check platform collisions
+		switch (type.category) {
+		case GameEngine::ObjectCategory::Platform: {
+			switch (type.platformColor()) {
+			case GameEngine::PlatformColor::Red: {
+				// Instant Loss
+				GameOver();
+			} break;
+			case GameEngine::PlatformColor::Yellow: {
+				// Lose fuel
+				gameState.playerState.fuel -= Constants::fuelLoss;
+				entities.renders[PlayerIndex()].distortedTime = Constants::powerAnimationTime;
+			} break;
+			case GameEngine::PlatformColor::Orange: {
+				// Speed up
+				gameState.playerState.isFullSpeed = true;
+				gameState.playerState.forcedSpeedStart = time;
+				gameState.playerState.oldPlayerSpeed = gameState.playerState.playerSpeed;
+				gameState.playerState.playerSpeed = Constants::maxSpeed;
+				entities.renders[PlayerIndex()].distortedTime = Constants::forcedSpeedTime;
+			} break;
+			case GameEngine::PlatformColor::Green: {
+				// Gain fuel
+				gameState.playerState.fuel += Constants::fuelGain;
+				entities.renders[PlayerIndex()].distortedTime = Constants::powerAnimationTime;
+				if (gameState.playerState.fuel > Constants::maxFuel) {
+					gameState.playerState.fuel = Constants::maxFuel;
+				}
+			} break;
+			case GameEngine::PlatformColor::White: {
+				if (gameState.playerState.lives < Constants::maxLives) {
+					// Gain life
+					gameState.playerState.lives += 1;
+					entities.renders[PlayerIndex()].distortedTime = Constants::powerAnimationTime;
+				}
+			} break;
+			default:
+				break;
+			}
+
+			entities.types[id] = GameEngine::ObjectType::Platform(GameEngine::PlatformColor::Purple);
+			GameEngine::GameObject::UpdatePlatformData(entities.types[id], entities.renders[id].material);
+		} break;
+		case GameEngine::ObjectCategory::Obstacle: {
+			if (type.obstacleKind() == GameEngine::ObstacleKind::Good) {
+				gameState.collected++;
+				toRemove.push_back(handle);
+			}
+			else if (type.obstacleKind() == GameEngine::ObstacleKind::Bad) {
+				gameState.playerState.lives--;
+				if (gameState.playerState.lives <= 0) {
+					GameOver();
+				}
+				toRemove.push_back(handle);
+			}
+		} break;
+		default:
+			break;
+		}
+	}
+
+	for (auto& handle : toRemove) {
+		removeGameObject(handle);
+	}
+}
+
+void GameSimulation::ComputeScore()
+{
+	gameState.points = abs(entities.bodies[PlayerIndex()].state.x.z - Constants::playerStartingPosition.z);
+}
+
+void GameSimulation::GameOver()
+{
+	gameOver = true;
+}
+
+void GameSimulation::DecorationManagement() {
+	while (gameState.decorationCount < Constants::maxDecorations - 3 && HasRoom(1)) {
+		int renderDecoration = decorationRandom.Bounded(100);
+
+		int side = decorationRandom.Bounded(2);
+		float x = decorationRandom.Bounded((int)(Constants::maxDecXOff - Constants::minDecXOff)) + Constants::minDecXOff;
+		float y = (float)decorationRandom.Bounded((int)Constants::maxDecY);
+		float zoff = decorationRandom.Bounded((int)(Constants::maxZOffset - Constants::minZOffset)) + Constants::minZOffset;
+		float z;
+		if (side == 0) {
+			x = -x;
+			z = gameState.decorationLeftZ;
+			gameState.decorationLeftZ -= zoff;
+		}
+		else {
+			z = gameState.decorationRightZ;
+			gameState.decorationRightZ -= zoff;
+		}
+
+		glm::vec3 position(x, y, z);
+
+		float impulse[3];
+		decorationRandom.FillRange(impulse, 3, 0.f, 5.f);
+
+		if (renderDecoration < Constants::starPercent) {
+			GameEngine::EntityHandle star = spawnGameObject(GameEngine::ObjectType(GameEngine::ObjectCategory::Star, decorationRandom.Bounded(GameEngine::ObjectConstants::starKinds)), position);
+			entities.bodies[entities.IndexOf(star)].addImpulse(glm::vec3(impulse[0], impulse[1], impulse[2]));
+			gameState.decorationCount++;
+			gameState.starsCount++;
+		}
+		else {
+			GameEngine::EntityHandle planet = spawnGameObject(GameEngine::ObjectType(GameEngine::ObjectCategory::Planet, decorationRandom.Bounded(GameEngine::ObjectConstants::planetKinds)), position);
+			entities.bodies[entities.IndexOf(planet)].addImpulse(glm::vec3(impulse[0], impulse[1], impulse[2]));
+			gameState.decorationCount++;
+		}
+	}
+
+	// Check what decorations are out of sight (need to be removed)
+	glm::vec3 playerPosition = entities.transforms[PlayerIndex()].position;
+	toRemove.clear();
+	for (size_t i = 0; i < entities.Count(); ++i) {
+		const GameEngine::ObjectType type = entities.types[i];
+		if (type.is(GameEngine::ObjectCategory::Star) || type.is(GameEngine::ObjectCategory::Planet)) {
+			glm::vec3 position = entities.transforms[i].position;
+			if (glm::distance(position, playerPosition) > Constants::despawnDistance &&
+				position.z > playerPosition.z) {
+				toRemove.push_back(entities.handles[i]);
+			}
+		}
+	}
+
+	// Remove the decorations
+	for (auto& handle : toRemove) {
+		if (entities.types[entities.IndexOf(handle)].is(GameEngine::ObjectCategory::Star)) {
+			gameState.starsCount--;
+		}
+		gameState.decorationCount--;
+		removeGameObject(handle);
+	}
+}
+
+bool GameSimulation::HasRoom(const size_t count) const
+{
+	return entities.Count() + count <= entityCapacity;
+}
+
+void GameSimulation::PlatformManagement()
+{
+	// This function manages all the platforms, their spawning and removal
+	// The platforms are decided by the track generator, in chunks; here, they are only placed on the lanes
+	// (the lanes are chosen here, because the lane ends are moved when they fall behind the player)
+	// A chunk adds at most a platform and an obstacle for every piece
+	while (gameState.platformCount + (int)Constants::chunkPlatforms <= Constants::maxPlatforms && HasRoom(2 * Constants::chunkPlatforms)) {
+		TrackChunk chunk;
+		track->Next(chunk);
+
+		std::vector<float>& nps = gameState.nextPlatformSpawn;
+		for (auto& piece : chunk.pieces) {
+			// The lane that hasn't spawned a platform in the longest time (max, because the z is in descending order)
+			size_t lane = std::max_element(nps.begin(), nps.end()) - nps.begin();
+			float z = nps[lane];
+			spawnGameObject(GameEngine::ObjectType::Platform(piece.color), glm::vec3(Constants::lanesX[lane], -0.125, z));
+
+			if (piece.hasObstacle) {
+				// The bad obstacles are in the middle lane
+				float x = piece.obstacle == GameEngine::ObstacleKind::Bad ? Constants::lanesX[1] : Constants::lanesX[lane];
+				spawnGameObject(GameEngine::ObjectType::Obstacle(piece.obstacle), glm::vec3(x, 1, z));
+			}
+
+			// Update the next platform spawn for that lane
+			nps[lane] -= GameEngine::ObjectConstants::platformLength + piece.gap;
+		}
+		gameState.platformCount += Constants::chunkPlatforms;
+	}
+
+	// Check what platforms are out of sight (need to be removed)
+	float despawnZ = entities.transforms[PlayerIndex()].position.z + GameEngine::ObjectConstants::platformLength / 2 + Constants::noSpawnRange;
+	toRemove.clear();
+	for (size_t i = 0; i < entities.Count(); ++i) {
+		const GameEngine::ObjectType type = entities.types[i];
+		if (type.is(GameEngine::ObjectCategory::Platform)) {
+			if (entities.transforms[i].position.z > despawnZ) {
+				toRemove.push_back(entities.handles[i]);
+			}
+		} else
+		if (type.is(GameEngine::ObjectCategory::Obstacle)) {
+			if (entities.transforms[i].position.z > despawnZ) {
+				toRemove.push_back(entities.handles[i]);
+			}
+		}
+	}
+	
+	// Remove the platforms and the obstacles (only the platforms are counted)
+	for (auto& handle : toRemove) {
+		if (entities.types[entities.IndexOf(handle)].is(GameEngine::ObjectCategory::Platform)) {
+			gameState.platformCount--;
+		}
+		removeGameObject(handle);
+	}
+
+	// Update the nextPlatformSpawn in case it got too low
+	for (int i = 0; i < gameState.nextPlatformSpawn.size(); ++i) {
+		// A next platform z is too low if the distance between it's center and the player's center (on the Z axis) is greater than the despawn range 
+		if (gameState.nextPlatformSpawn[i] > entities.transforms[PlayerIndex()].position.z - Constants::noSpawnRange) {
+			gameState.nextPlatformSpawn[i] = entities.transforms[PlayerIndex()].position.z - 2 * Constants::noSpawnRange;
+		}
+	}
+}
\ No newline at end of file
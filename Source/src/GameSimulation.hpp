@@ -0,0 +1,344 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <utility>
+#include <memory>
+#include <cstdint>
+
+#include "GameEngine/GameObject.hpp"
+#include "GameEngine/EntityStore.hpp"
+#include "GameEngine/SpawnPool.hpp"
+#include "GameEngine/Broadphase.hpp"
+#include "GameEngine/Random.hpp"
+#include "GameEngine/JobSystem.hpp"
+#include "GameEngine/Lighting.hpp"
+
+namespace Skyroads {
+	namespace Constants {
+		const std::vector<std::string> shaderNames{ "Base", "UI", "ScreenShader", "Skybox", "Blur", "Spaceship", "EmmisiveTransparency", "Planet", "EmmisiveTransparencyInstanced", "PlanetInstanced", "BloomDownsample", "BloomUpsample" };
+		const std::vector<std::string> meshNames{ "box", "sphere"};
+		const std::vector<std::string> textureNames{ "life", "skybox", "spaceship_window", "spaceship_exhaust", "icy", "jupiter", "mars", "neptune", "star_blue", "star_red", "uranus", "venus", "obstacle1", "obstacle2" };
+		const std::vector<std::string> modelNames{ "platform", "spaceship" };
+		const bool parallelTextureLoading = true;	// Decode the textures on worker threads (false - one by one, on the main thread)
+		const bool useCompressedTextures = true;	// Load the baked .ktx textures instead of the .png ones, when they exist
+		const bool useBakedMeshes = true;			// Load the baked .mesh files instead of importing the .obj ones (they are baked when missing or outdated)
+		const bool useShaderCache = true;			// Save the linked shader programs and load them on the next runs (if the sources and the driver didn't change)
+
+		const glm::vec3 lightPositionOffset = glm::vec3(0., 7.75f, 0.);
+		const glm::vec3 playerStartingPosition = glm::vec3(0, 20.f, 35.f);
+
+		const std::vector<float> lanesX{ -3.5f, 0.f, 3.5f };
+
+		// Player constants
+		const float maxSpeed = 0.125f;
+		const float minSpeed = 0.0075f;
+		const float speedStep = 0.001f;
+		const float lateralSpeed = .75f;
+
+		// Game Constants
+		const double tickRate = 60;				// Game logic updates per second
+		const float forcedSpeedTime = 5;		// In seconds
+		const double powerAnimationTime = 2;	// In seconds
+		const float maxLives = 3;
+		const int maxPlatforms = 12;
+		const unsigned int chunkPlatforms = 4;		// The number of platforms in a chunk of the track
+		const unsigned int chunksAhead = 8;		// The number of chunks generated in advance (a power of two)
+		const int minPlatformGap = 5;
+		const int maxPlatformGap = GameEngine::ObjectConstants::platformLength;
+		const int simplePlatPercent = 60;
+		const float noSpawnRange = 10.f;
+		const float outOfBoundY = -3.5f;
+		const int obstaclesPercent = 10;
+		const int pointsPercent = 10;
+		
+		// Job constants (smaller ranges are not split between threads). A game has at most
+		// 1 + 2 * maxPlatforms + maxDecorations objects, so its physics and culling stay on the
+		// calling thread - a job would cost more than it saves. Larger scenes (--bench-jobs) are split.
+		const size_t bodiesPerJob = 512;		// The bodies integrated by a physics job (a multiple of 8)
+		const size_t objectsPerJob = 256;		// The objects culled by a render job
+
+		// Fuel constants
+		const float maxFuel = 100.f;
+		const float fuelGain = 0.33f * maxFuel;
+		const float fuelLoss = 0.10f * maxFuel;
+		const float fuelFlow = 2.5f;									// The "fuelFlow" factor
+		const glm::vec3 fuelbarScale = glm::vec3(0.07, 1.9f, 1);		// The maximum scale/size of the fuelbar
+		const float fuelbarsDiff = 0.01;
+		const glm::vec3 fuelbarColor = glm::vec3(0.9, 0.6, 0.2);
+		const glm::vec3 fuelbarBackgroundColor = glm::vec3(0.5f);
+
+		// UI constants
+		const unsigned int scoreDigits = 6;							// The number of digits of the score shown in the UI
+		const glm::vec3 scoreColor = glm::vec3(0.95f);
+
+		// Camera constants
+		const float minFov = 60.f;
+		const float maxFov = 90.f;
+
+		// Decoration constants
+		const int maxDecorations = 16;
+		const int maxStars = 2;
+		const float starPercent = 5.f;
+		const float minZOffset = 5.f;
+		const float maxZOffset = 30.f;
+		const float despawnDistance = 10.f;
+		const float maxDecY = 15.f;
+		const float minDecXOff = 6.5f;
+		const float maxDecXOff = 35.f;
+
+		// Rendering constants
+		const float gamma = 1.2f;
+		const float exposure = 0.5f;
+		const unsigned int multisamples = 4;	// The default MSAA sample count
+		const float renderScale = 1.f;			// The default size of the render targets, relative to the window
+		const unsigned int blur_amount = 10;	// Blur iterations
+		const float bloomThreshold = 1.f;		// The brightness above which a color blooms (mip-chain bloom)
+		const float bloomStrength = 0.2f;		// How much of the mip-chain bloom is added to the scene
+	};
+
+	// Defines variables used in the game logic
+	struct GameState {
+		struct PlayerState {
+			float fuel = Constants::maxFuel;
+			bool isFullSpeed = false;
+			double forcedSpeedStart = 0;	// The start time of the forced speed effect
+			float lives = 1;
+			float playerSpeed = 0.05f;
+			float oldPlayerSpeed = 0.05f;   // The speed of the player before the forced speed effect
+			bool isInJump = true;
+		};
+		PlayerState playerState;
+
+		float points = 0.f;
+		float collected = 0;	// How many good objects he has collected
+
+		// Data related to the platforms and decorations
+		std::vector<float> nextPlatformSpawn = {Constants::playerStartingPosition.z, Constants::playerStartingPosition.z + 1, Constants::playerStartingPosition.z };
+		int platformCount = 0;
+		int decorationCount = 0;
+		int starsCount = 0;
+		bool gameStarted;
+		int decorationLeftZ = 0;
+		int decorationRightZ = 0;
+	};
+
+
+	/// <summary>
+	/// Map a value that is in a range to another range
+	/// </summary>
+	/// <param name="sourceNumber">The value</param>
+	/// <param name="fromA">Starting value of the first range</param>
+	/// <param name="fromB">End value of the first range</param>
+	/// <param name="toA">Starting value of the second range</param>
+	/// <param name="toB">End value of the second range</param>
+	/// <param name="decimalPrecision">The number of decimals to use</param>
+	/// <returns>The mapped value</returns>
+	double mapBetweenRanges(double sourceNumber, double fromA, double fromB, double toA, double toB, int decimalPrecision);
+
+	/// <summary>
+	/// The ids of the random number streams used by the game logic. Every system has its own
+	/// stream, seeded from the seed of the game, so changing how one of them uses random numbers
+	/// doesn't change what the others generate.
+	/// </summary>
+	namespace RandomStreams {
+		const uint64_t Platforms = 1;
+		const uint64_t Decorations = 2;
+	}
+
+	/// <summary>
+	/// The keys that control the player, as bits in a TickInput
+	/// </summary>
+	namespace InputKeys {
+		const unsigned char Left = 1 << 0;
+		const unsigned char Right = 1 << 1;
+		const unsigned char Faster = 1 << 2;
+		const unsigned char Slower = 1 << 3;
+		const unsigned char Jump = 1 << 4;
+	}
+
+	/// <summary>
+	/// The player input used in a simulation tick
+	/// </summary>
+	struct TickInput {
+		unsigned char keys = 0;
+
+		bool isPressed(const unsigned char key) const {
+			return (keys & key) != 0;
+		}
+	};
+
+	class TrackGenerator;
+
+	/// <summary>
+	/// The game logic (player, platforms, decorations, physics and collisions), without any
+	/// rendering. It doesn't need an OpenGL context or a window, so it can also run "headless".
+	/// The time used by the game logic is the simulation time (the sum of the tick durations),
+	/// not the time of the window.
+	/// </summary>
+	class GameSimulation {
+	public:
+		GameSimulation();
+		~GameSimulation();
+
+		/// <summary>
+		/// Create the player and reset the game state. The random numbers used by the game logic
+		/// are seeded here, so a game started with the same seed and given the same input has the same result.
+		/// </summary>
+		/// <param name="seed">The seed of the game</param>
+		void Init(const unsigned int seed);
+
+		/// <summary>
+		/// Set the job system used to update the objects in parallel (without one, everything runs on the calling thread)
+		/// </summary>
+		/// <param name="jobs">The job system</param>
+		void SetJobSystem(GameEngine::JobSystem* jobs);
+
+		/// <summary>
+		/// Advance the game logic by one step
+		/// </summary>
+		/// <param name="input">The player input</param>
+		/// <param name="deltaTime">The duration of the step, in seconds</param>
+		void Tick(const TickInput& input, const float deltaTime);
+
+		/// <summary>
+		/// Add a game object to the scene
+		/// </summary>
+		/// <param name="object">The game object</param>
+		/// <returns>The handle of the new entity</returns>
+		GameEngine::EntityHandle addGameObject(const GameEngine::GameObject& object);
+
+		/// <summary>
+		/// Add an object to the scene, copied from the prototype of its archetype (see SpawnPool)
+		/// </summary>
+		/// <param name="type">The type of the object</param>
+		/// <param name="position">The position of the object</param>
+		/// <returns>The handle of the new entity</returns>
+		GameEngine::EntityHandle spawnGameObject(const GameEngine::ObjectType type, const glm::vec3& position);
+
+		/// <summary>
+		/// Remove a game object from the scene
+		/// </summary>
+		/// <param name="handle">The handle of the entity</param>
+		void removeGameObject(const GameEngine::EntityHandle handle);
+
+		/// <summary>
+		/// Get the index of the player in the entity arrays
+		/// </summary>
+		/// <returns>The index</returns>
+		size_t PlayerIndex() const;
+
+		/// <summary>
+		/// Check if the game has ended (all lives lost, fell off the platforms, red platform)
+		/// </summary>
+		/// <returns>If the game is over</returns>
+		bool isGameOver() const;
+
+		/// <summary>
+		/// Get the final score of the game
+		/// </summary>
+		/// <returns>The score</returns>
+		int getScore() const;
+
+		/// <summary>
+		/// Get the simulation time
+		/// </summary>
+		/// <returns>The time, in seconds</returns>
+		double getTime() const;
+
+		/// <summary>
+		/// Get the seed the game was started with
+		/// </summary>
+		/// <returns>The seed</returns>
+		unsigned int getSeed() const;
+
+		/// <summary>
+		/// Compute a hash of the state of the game (the time, the score, the player state and
+		/// the positions of all the objects). Two runs ended in the same state if their hashes match.
+		/// </summary>
+		/// <returns>The hash (FNV-1a, 64 bits)</returns>
+		uint64_t StateHash() const;
+
+		GameEngine::EntityStore& getEntities();
+		GameState& getGameState();
+
+	private:
+		/// <summary>
+		/// All the objects in the scene, stored as component arrays
+		/// </summary>
+		GameEngine::EntityStore entities;
+		GameEngine::SpawnPool spawnPool;		// The prototypes of the platforms, obstacles and decorations
+		GameEngine::Broadphase broadphase;		// Indexed by the slot index of the entity handles
+		std::vector<std::pair<unsigned int, unsigned int>> broadphasePairs;
+		GameEngine::BodyBatch bodyBatch;		// The states of the simulated bodies, packed for the integrator
+		std::vector<size_t> batchIndices;		// The entity index of every body in the batch
+		GameEngine::JobSystem* jobs;
+		std::vector<GameEngine::EntityHandle> collided;		// The objects the player collided with, in the current tick
+		std::vector<GameEngine::EntityHandle> toRemove;		// The objects removed at the end of a step (reused, like the other buffers)
+		GameEngine::EntityHandle player;
+		GameState gameState;
+		std::unique_ptr<TrackGenerator> track;	// Generates the platforms and obstacles, on a worker thread
+		GameEngine::Random decorationRandom;	// Planets and stars
+
+		double time;
+		bool gameOver;
+		unsigned int seed;
+		size_t entityCapacity;		// The number of entities reserved in Init (nothing is spawned past it)
+
+		/// <summary>
+		/// Update the player data
+		/// </summary>
+		/// <param name="input">The player input</param>
+		void UpdatePlayer(const TickInput& input);
+
+		/// <summary>
+		/// Update all the data related to the game logic
+		/// </summary>
+		void UpdateGameState(const TickInput& input, const float deltaTime);
+
+		/// <summary>
+		/// Update the physics state of every object
+		/// </summary>
+		void UpdatePhysics(const float deltaTime);
+
+		/// <summary>
+		/// Find the objects the player collided with. Landing on a platform will
+		/// make the player "stick" to it.
+		/// </summary>
+		/// <returns>A vector with the handles of the collided objects (valid until the next tick)</returns>
+		const std::vector<GameEngine::EntityHandle>& ManageCollisions();
+
+		/// <summary>
+		/// Check collisions and update the game state
+		/// </summary>
+		/// <param name="collided">A vector with the handles of the collided objects</param>
+		void CheckCollisions(const std::vector<GameEngine::EntityHandle>& collided);
+
+		/// <summary>
+		/// Compute the score
+		/// </summary>
+		void ComputeScore();
+
+		/// <summary>
+		/// Mark the game as ended
+		/// </summary>
+		void GameOver();
+
+		/// <summary>
+		/// Check if some objects can be spawned without going over the reserved capacity
+		/// </summary>
+		/// <param name="count">The number of objects</param>
+		/// <returns>If there is room for them</returns>
+		bool HasRoom(const size_t count) const;
+
+		/// <summary>
+		/// Place the generated chunks of the track and remove the platforms/obstacles left behind
+		/// </summary>
+		void PlatformManagement();
+
+		/// <summary>
+		/// Spawn/Remove decorative elements from the game
+		/// </summary>
+		void DecorationManagement();
+	};
+}
\ No newline at end of file
@@ -0,0 +1,112 @@
+#include "InputRecording.hpp"
+
+#include <iostream>
+
+using namespace Skyroads;
+
+InputRecorder::InputRecorder() : ticks(0) {}
+
+InputRecorder::~InputRecorder()
+{
+	Close();
+}
+
+bool InputRecorder::Open(const std::string& path, const unsigned int seed, const float deltaTime)
+{
+	Close();
+	ticks = 0;
+
+	file.open(path, std::ios::binary | std::ios::trunc);
+	if (!file) {
+		std::cout << "Couldn't create the recording file '" << path << "'\n";
+		return false;
+	}
+
+	RecordingFormat::Header header;
+	header.magic = RecordingFormat::magic;
+	header.version = RecordingFormat::version;
+	header.seed = seed;
+	header.deltaTime = deltaTime;
+	file.write((const char*)&header, sizeof(header));
+	return true;
+}
+
+void InputRecorder::Record(const TickInput& input)
+{
+	if (!file.is_open()) return;
+
+	// The stream buffers the data, it is written to the disk in blocks
+	file.put((char)input.keys);
+	ticks++;
+}
+
+void InputRecorder::Close()
+{
+	if (file.is_open()) {
+		file.close();
+	}
+}
+
+bool InputRecorder::IsOpen() const
+{
+	return file.is_open();
+}
+
+unsigned long InputRecorder::Ticks() const
+{
+	return ticks;
+}
+
+InputReplay::InputReplay() : seed(0), deltaTime(0) {}
+
+bool InputReplay::Load(const std::string& path)
+{
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file) {
+		std::cout << "Couldn't open the recording file '" << path << "'\n";
+		return false;
+	}
+
+	std::streamoff size = file.tellg();
+	file.seekg(0);
+
+	RecordingFormat::Header header;
+	if (size < (std::streamoff)sizeof(header) || !file.read((char*)&header, sizeof(header))
+		|| header.magic != RecordingFormat::magic || header.version != RecordingFormat::version || header.deltaTime <= 0) {
+		std::cout << "'" << path << "' is not a valid recording file\n";
+		return false;
+	}
+
+	// Every byte after the header is a tick
+	keys.resize((size_t)(size - sizeof(header)));
+	if (!keys.empty() && !file.read((char*)keys.data(), keys.size())) {
+		keys.clear();
+		return false;
+	}
+
+	seed = header.seed;
+	deltaTime = header.deltaTime;
+	return true;
+}
+
+unsigned int InputReplay::Seed() const
+{
+	return seed;
+}
+
+float InputReplay::DeltaTime() const
+{
+	return deltaTime;
+}
+
+size_t InputReplay::Ticks() const
+{
+	return keys.size();
+}
+
+TickInput InputReplay::Input(const size_t tick) const
+{
+	TickInput input;
+	input.keys = keys[tick];
+	return input;
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <cstdint>
+
+#include "GameSimulation.hpp"
+
+namespace Skyroads {
+	/// <summary>
+	/// The file a game session is recorded in: a header with the seed of the game and the duration
+	/// of a tick, followed by the keys used in every tick (one byte per tick). The game logic only
+	/// depends on them, so the session can be simulated again with the same results.
+	/// </summary>
+	namespace RecordingFormat {
+		const uint32_t magic = 0x50524B53;	// "SKRP"
+		const uint32_t version = 1;
+
+		struct Header {
+			uint32_t magic;
+			uint32_t version;
+			uint32_t seed;
+			float deltaTime;
+		};
+	}
+
+	/// <summary>
+	/// Writes the input of a game session to a recording file, tick by tick
+	/// </summary>
+	class InputRecorder {
+	public:
+		InputRecorder();
+		~InputRecorder();
+
+		/// <summary>
+		/// Create the recording file and write its header
+		/// </summary>
+		/// <param name="path">The recording file</param>
+		/// <param name="seed">The seed the game was started with</param>
+		/// <param name="deltaTime">The duration of a tick, in seconds</param>
+		/// <returns>If the file was created</returns>
+		bool Open(const std::string& path, const unsigned int seed, const float deltaTime);
+
+		/// <summary>
+		/// Add the input of a tick to the recording
+		/// </summary>
+		/// <param name="input">The input passed to the simulation</param>
+		void Record(const TickInput& input);
+
+		/// <summary>
+		/// Write the remaining data and close the file. Called when the session ends.
+		/// </summary>
+		void Close();
+
+		bool IsOpen() const;
+
+		/// <summary>
+		/// Get the number of recorded ticks
+		/// </summary>
+		/// <returns>The number of ticks</returns>
+		unsigned long Ticks() const;
+
+	private:
+		std::ofstream file;
+		unsigned long ticks;
+	};
+
+	/// <summary>
+	/// A recorded game session, loaded in memory so it can be replayed as fast as possible
+	/// </summary>
+	class InputReplay {
+	public:
+		InputReplay();
+
+		/// <summary>
+		/// Load a recording file
+		/// </summary>
+		/// <param name="path">The recording file</param>
+		/// <returns>If the file was loaded (false if it doesn't exist or is invalid)</returns>
+		bool Load(const std::string& path);
+
+		unsigned int Seed() const;
+		float DeltaTime() const;
+		size_t Ticks() const;
+
+		/// <summary>
+		/// Get the input of a tick
+		/// </summary>
+		/// <param name="tick">The index of the tick</param>
+		/// <returns>The input</returns>
+		TickInput Input(const size_t tick) const;
+
+	private:
+		unsigned int seed;
+		float deltaTime;
+		std::vector<unsigned char> keys;
+	};
+}
\ No newline at end of file
@@ -48,9 +48,11 @@ in vec2 frag_coord;		// texture coordinate
 
 uniform vec3 eye_position; // or view position
 
-// Uniforms for light properties
-uniform int lights_count;
-uniform Light lights[max_light_sources];
+// Uniforms for light properties - shared by all the shaders (std140 uniform buffer, updated once per frame)
+layout(std140) uniform Lights {
+	int lights_count;
+	Light lights[max_light_sources];
+};
 
 // Uniforms for object properties
 uniform Material material;
@@ -0,0 +1,46 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+// The previous (larger) level of the mip chain, or the scene for the first pass
+uniform sampler2D image;
+
+// The first pass also extracts the bright parts of the scene
+uniform bool bright_pass;
+uniform float threshold;
+
+void main()
+{
+    vec2 texel = 1.0 / textureSize(image, 0);
+
+    // 13 samples around the current texel, weighted as 5 overlapping 2x2 boxes,
+    // so the result doesn't flicker when the bright spots move between texels
+    vec3 a = texture(image, TexCoords + texel * vec2(-2.0, 2.0)).rgb;
+    vec3 b = texture(image, TexCoords + texel * vec2(0.0, 2.0)).rgb;
+    vec3 c = texture(image, TexCoords + texel * vec2(2.0, 2.0)).rgb;
+    vec3 d = texture(image, TexCoords + texel * vec2(-2.0, 0.0)).rgb;
+    vec3 e = texture(image, TexCoords).rgb;
+    vec3 f = texture(image, TexCoords + texel * vec2(2.0, 0.0)).rgb;
+    vec3 g = texture(image, TexCoords + texel * vec2(-2.0, -2.0)).rgb;
+    vec3 h = texture(image, TexCoords + texel * vec2(0.0, -2.0)).rgb;
+    vec3 i = texture(image, TexCoords + texel * vec2(2.0, -2.0)).rgb;
+    vec3 j = texture(image, TexCoords + texel * vec2(-1.0, 1.0)).rgb;
+    vec3 k = texture(image, TexCoords + texel * vec2(1.0, 1.0)).rgb;
+    vec3 l = texture(image, TexCoords + texel * vec2(-1.0, -1.0)).rgb;
+    vec3 m = texture(image, TexCoords + texel * vec2(1.0, -1.0)).rgb;
+
+    vec3 result = e * 0.125;
+    result += (a + c + g + i) * 0.03125;
+    result += (b + d + f + h) * 0.0625;
+    result += (j + k + l + m) * 0.125;
+
+    if (bright_pass)
+    {
+        // Keep only the part of the color above the threshold
+        float brightness = max(result.r, max(result.g, result.b));
+        result *= max(brightness - threshold, 0.0) / max(brightness, 0.0001);
+    }
+
+    FragColor = vec4(result, 1.0);
+}
\ No newline at end of file
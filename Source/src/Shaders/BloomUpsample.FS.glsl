@@ -0,0 +1,26 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec2 TexCoords;
+
+// The previous (smaller) level of the mip chain
+uniform sampler2D image;
+
+// The radius of the filter, in texels of the source level
+uniform float filter_radius;
+
+void main()
+{
+    vec2 offset = filter_radius / textureSize(image, 0);
+    float x = offset.x;
+    float y = offset.y;
+
+    // 3x3 tent filter
+    vec3 result = texture(image, TexCoords).rgb * 4.0;
+    result += (texture(image, TexCoords + vec2(-x, 0.0)).rgb + texture(image, TexCoords + vec2(x, 0.0)).rgb +
+               texture(image, TexCoords + vec2(0.0, -y)).rgb + texture(image, TexCoords + vec2(0.0, y)).rgb) * 2.0;
+    result += texture(image, TexCoords + vec2(-x, y)).rgb + texture(image, TexCoords + vec2(x, y)).rgb +
+              texture(image, TexCoords + vec2(-x, -y)).rgb + texture(image, TexCoords + vec2(x, -y)).rgb;
+
+    FragColor = vec4(result / 16.0, 1.0);
+}
\ No newline at end of file
@@ -0,0 +1,39 @@
+#version 330
+
+layout(location = 0) in vec3 v_position;
+layout(location = 1) in vec3 v_normal;
+layout(location = 2) in vec2 v_texture_coord;
+layout(location = 3) in vec3 v_color;
+
+// Per-instance properties
+layout(location = 4) in mat4 i_model;			// Uses the locations 4 - 7
+layout(location = 8) in vec3 i_emmisive;
+layout(location = 9) in vec3 i_ambient;
+layout(location = 10) in float i_shininess;
+
+// Uniform properties
+uniform mat4 View;
+uniform mat4 Projection;
+
+// Output values to fragment shader
+out vec3 world_position;	// fragment position
+out vec3 world_normal;		// normal vector
+out vec2 frag_coord;		// texture coordinate
+
+flat out vec3 material_emmisive;
+flat out vec3 material_ambient;
+flat out float material_shininess;
+
+void main()
+{
+	// Compute world space vertex position and normal
+	world_position = (i_model * vec4(v_position, 1)).xyz;
+	world_normal = normalize( mat3(i_model) * normalize(v_normal));
+	frag_coord = v_texture_coord;
+
+	material_emmisive = i_emmisive;
+	material_ambient = i_ambient;
+	material_shininess = i_shininess;
+
+	gl_Position = Projection * View * i_model * vec4(v_position, 1.0);
+}
\ No newline at end of file
@@ -6,6 +6,7 @@ uniform sampler2D screenTexture;
 uniform sampler2D bloomTexture;
 uniform float gamma;
 uniform float exposure;
+uniform float bloom_strength;
 
 out vec4 FragColor;
 
@@ -14,7 +15,7 @@ void main()
     // Hdr tone mapping
     vec3 color = texture(screenTexture, TexCoords).rgb;
     vec3 bloom_color = texture(bloomTexture, TexCoords).rgb;
-    color += bloom_color;
+    color += bloom_color * bloom_strength;
 
     vec3 result = vec3(1.0) - exp(-color * exposure);
     result = pow(result, vec3(1.0 / gamma));
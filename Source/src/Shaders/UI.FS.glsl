@@ -1,25 +1,33 @@
 #version 330
 
-uniform sampler2D texture1;
-uniform bool has_texture;
+// The textures of the batch (bound to the units 0-3)
+uniform sampler2D u_texture_0;
+uniform sampler2D u_texture_1;
+uniform sampler2D u_texture_2;
+uniform sampler2D u_texture_3;
 
 in vec2 frag_coord;
+in vec3 frag_color;
+flat in int texture_slot;
 
 out vec4 out_color;
 
-uniform vec3 object_color;
-
 // Constants
 float cutoff = 0.1;
 
 void main()
 {
-	vec4 texturedColor = texture(texture1, frag_coord);
-
-	if(has_texture) {
-		out_color = texturedColor;
+	// The slot is the same for the whole quad (-1 if it is not textured)
+	if (texture_slot == 0) {
+		out_color = texture(u_texture_0, frag_coord);
+	} else if (texture_slot == 1) {
+		out_color = texture(u_texture_1, frag_coord);
+	} else if (texture_slot == 2) {
+		out_color = texture(u_texture_2, frag_coord);
+	} else if (texture_slot == 3) {
+		out_color = texture(u_texture_3, frag_coord);
 	} else {
-		out_color = vec4(object_color, 1.f);
+		out_color = vec4(frag_color, 1.f);
 	}
 
 	if (out_color.a < cutoff)
@@ -1,19 +1,19 @@
 #version 330
 
-layout(location = 0) in vec3 v_position;
-layout(location = 1) in vec3 v_normal;
-layout(location = 2) in vec2 v_texture_coord;
-layout(location = 3) in vec3 v_color;
-
-// Uniform properties
-uniform mat4 Model;
-uniform mat4 View;
-uniform mat4 Projection;
+// The quads of the sprite batch, already in normalized device coordinates
+layout(location = 0) in vec2 v_position;
+layout(location = 1) in vec2 v_texture_coord;
+layout(location = 2) in vec3 v_color;
+layout(location = 3) in float v_texture_slot;
 
 out vec2 frag_coord;
+out vec3 frag_color;
+flat out int texture_slot;
 
 void main()
 {
 	frag_coord = v_texture_coord;
-	gl_Position = Projection * View * Model * vec4(v_position, 1.0);
+	frag_color = v_color;
+	texture_slot = int(v_texture_slot);
+	gl_Position = vec4(v_position, 0.0, 1.0);
 }
\ No newline at end of file
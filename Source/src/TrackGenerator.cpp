@@ -0,0 +1,126 @@
+#include "TrackGenerator.hpp"
+
+using namespace Skyroads;
+
+TrackGenerator::TrackGenerator() : generated(0), stopping(false) {}
+
+TrackGenerator::~TrackGenerator()
+{
+	Stop();
+}
+
+void TrackGenerator::Start(const unsigned int seed)
+{
+	Stop();
+
+	// Drop the chunks of the previous track
+	TrackChunk chunk;
+	while (queue.TryPop(chunk));
+
+	random.Seed(seed, RandomStreams::Platforms);
+	generated = 0;
+	stopping = false;
+	worker = std::thread(&TrackGenerator::Work, this);
+}
+
+void TrackGenerator::Stop()
+{
+	if (!worker.joinable()) return;
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	chunkTaken.notify_one();
+	worker.join();
+}
+
+void TrackGenerator::Next(TrackChunk& chunk)
+{
+	if (!queue.TryPop(chunk)) {
+		std::unique_lock<std::mutex> lock(mutex);
+		chunkAdded.wait(lock, [this, &chunk] { return queue.TryPop(chunk); });
+	}
+
+	// The lock makes sure the worker is either before its check or already waiting
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+	}
+	chunkTaken.notify_one();
+}
+
+void TrackGenerator::Work()
+{
+	while (true) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			chunkTaken.wait(lock, [this] { return stopping || !queue.Full(); });
+			if (stopping) return;
+		}
+
+		// Generate outside of the lock
+		TrackChunk chunk;
+		Generate(chunk);
+		queue.TryPush(chunk);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+		}
+		chunkAdded.notify_one();
+	}
+}
+
+void TrackGenerator::Generate(TrackChunk& chunk)
+{
+	using namespace GameEngine;
+
+	for (auto& piece : chunk.pieces) {
+		int platType = random.Bounded(100);
+		if (generated < Constants::lanesX.size()) {
+			platType = 0;	// First platforms should be simple
+		}
+
+		int platGap = random.Range(Constants::minPlatformGap, Constants::maxPlatformGap);
+
+		if (platType < Constants::simplePlatPercent) {
+			piece.color = PlatformColor::Blue;
+		}
+		else {
+			// Effect platform
+			platType = (int)mapBetweenRanges(platType, Constants::simplePlatPercent, 100, 0, 9, 1);
+
+			if (platType < 1) {
+				piece.color = PlatformColor::Red;		// Very few
+			}
+			else if (platType < 4) {
+				piece.color = PlatformColor::Yellow;	// Some
+			}
+			else if (platType < 6) {
+				piece.color = PlatformColor::Green;		// Few
+			}
+			else if (platType < 8) {
+				piece.color = PlatformColor::Orange;	// Few
+			}
+			else {
+				piece.color = PlatformColor::White;		// Very few
+			}
+		}
+
+		piece.hasObstacle = false;
+		int obstacle = random.Bounded(100);
+		if (obstacle < Constants::obstaclesPercent) {
+			piece.hasObstacle = true;
+			piece.obstacle = ObstacleKind::Bad;
+		}
+		else {
+			int collectible = random.Bounded(100);
+			if (collectible < Constants::pointsPercent) {
+				piece.hasObstacle = true;
+				piece.obstacle = ObstacleKind::Good;
+			}
+		}
+
+		piece.gap = (float)platGap;
+		generated++;
+	}
+}
\ No newline at end of file
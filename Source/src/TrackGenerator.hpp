@@ -0,0 +1,80 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+
+#include "GameSimulation.hpp"
+#include "GameEngine/SpscQueue.hpp"
+
+namespace Skyroads {
+	/// <summary>
+	/// A platform of the track, with the obstacle or collectible placed on it. Its lane is chosen
+	/// by the simulation when it's placed.
+	/// </summary>
+	struct TrackPiece {
+		GameEngine::PlatformColor color;
+		bool hasObstacle;
+		GameEngine::ObstacleKind obstacle;	// Bad obstacles are always in the middle lane
+		float gap;							// The empty space after the platform, on its lane
+	};
+
+	/// <summary>
+	/// A fixed length segment of the track
+	/// </summary>
+	struct TrackChunk {
+		TrackPiece pieces[Constants::chunkPlatforms];
+	};
+
+	/// <summary>
+	/// Generates the track ahead of the player on a worker thread. The chunks are decided by the
+	/// platform random stream only, so they don't depend on the game state or on the timing of the
+	/// thread - a game started with the same seed always gets the same track. The worker keeps up to
+	/// Constants::chunksAhead chunks ready in a lock-free queue, and the simulation only places them.
+	/// </summary>
+	class TrackGenerator {
+	public:
+		TrackGenerator();
+		~TrackGenerator();
+
+		/// <summary>
+		/// Start generating a new track (stopping the previous one)
+		/// </summary>
+		/// <param name="seed">The seed of the game</param>
+		void Start(const unsigned int seed);
+
+		/// <summary>
+		/// Stop the worker thread
+		/// </summary>
+		void Stop();
+
+		/// <summary>
+		/// Get the next chunk of the track. If the worker didn't generate it yet, waits for it.
+		/// </summary>
+		/// <param name="chunk">Where the chunk is copied</param>
+		void Next(TrackChunk& chunk);
+
+	private:
+		GameEngine::SpscQueue<TrackChunk, Constants::chunksAhead> queue;
+		GameEngine::Random random;		// Only used by the worker
+		unsigned int generated;			// The number of generated platforms
+
+		std::thread worker;
+		std::atomic<bool> stopping;
+		std::mutex mutex;					// Only used to sleep and wake up the threads, the queue is lock-free
+		std::condition_variable chunkAdded;
+		std::condition_variable chunkTaken;
+
+		/// <summary>
+		/// The loop of the worker thread
+		/// </summary>
+		void Work();
+
+		/// <summary>
+		/// Decide the platforms of a chunk (the same way the platforms were spawned one by one)
+		/// </summary>
+		/// <param name="chunk">The chunk</param>
+		void Generate(TrackChunk& chunk);
+	};
+}
\ No newline at end of file